@@ -1,20 +1,27 @@
 #ifndef BASE_CHIBIS_HPP
 #define BASE_CHIBIS_HPP
 
-#include <avr/pgmspace.h>
+#include "basePgm.hpp"
 #include "halDisplay.hpp"
+#include "halGray.hpp"
+#include "gaugeConfig.hpp"
 
 #define NUM_PIXELS			SCREEN_WIDTH * SCREEN_HEIGHT
 #define LEN_IMG_BYTE_ARR		NUM_PIXELS / 8
 
-const bool CHIBIS_DEBUG = false;
-
 // 128x60px
 extern const unsigned char IMG_DECOMPRESSED[];
 extern const unsigned char HAPPY_CHIBI [LEN_IMG_BYTE_ARR] PROGMEM;
 extern const unsigned char BLANK_CHIBI [LEN_IMG_BYTE_ARR] PROGMEM;
 extern const unsigned char * ALL_CHIBIS[] PROGMEM;
+// 2bpp planes in page layout, see halGray.hpp
+extern const unsigned char GRAY_HAPPY_CHIBI_HIGH [LEN_IMG_BYTE_ARR] PROGMEM;
+extern const unsigned char GRAY_HAPPY_CHIBI_LOW [LEN_IMG_BYTE_ARR] PROGMEM;
+extern const GRAY_IMAGE GRAY_HAPPY_CHIBI;
+#ifndef DISPLAY_PAGE_MODE
+// Full-screen scratch image for animations. Not available in page mode.
 extern unsigned char chibiOutputImage [LEN_IMG_BYTE_ARR];
+#endif
 
 typedef struct _COMPRESSED_CHIBI
 {
@@ -48,9 +55,11 @@ typedef enum _ENUM_ALL_CHIBIS
 
 void rleDecompressImage(const unsigned char * CompImage);
 
+#ifndef DISPLAY_PAGE_MODE
 unsigned char * chibisAnimateBlankToSmile(unsigned char Frame);
 
 void chibisLoadBaseOutputFrame(unsigned char Index);
+#endif
 
 CHIBIS_STATUS chibisDrawPixel(unsigned char OriginX, unsigned char OriginY, char OffsetX, char OffsetY);
 
@@ -0,0 +1,90 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   baseConvert.hpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Declarations for the ADC code -> resistance -> temperature
+*   conversion and the sample filters. No Arduino dependencies, so the
+*   same code runs in the firmware and in the host tools.
+*
+*/
+
+#ifndef BASE_CONVERT_HPP
+#define BASE_CONVERT_HPP
+
+#include <stdint.h>
+#include "basePgm.hpp"
+#include "gaugeConfig.hpp"
+
+#define NUM_RES_VALUES      16      // Number of resistance and temperature values stored for reference
+
+#define RES_SCALE_FACTOR    1       // Factor that RESISTANCE_VALS values are scaled down by
+
+// PARALLEL ARRAYS, in flash. Read them with pgm_read_word().
+extern const uint16_t RESISTANCE_VALS[] PROGMEM;    // Stored resistance values of thermistor at temps in TEMP_VALS
+extern const uint16_t TEMP_VALS[] PROGMEM;          // Stored temperature values at each resistance value in RESISTANCE_VALS
+
+// Rolling average with its length fixed at build time, so the wrap-around is a compare
+// instead of a modulo and the divide is by a constant.
+template <unsigned int Len>
+struct FIXED_BOXCAR_FILTER
+{
+  int Samples[Len];
+  unsigned int It;
+  long Sum;
+};
+
+// R = series resistor * code / (full scale - code). The reference voltage cancels out of the
+// divider equation, so only the code is needed. Every ADC conversion goes through this.
+inline float convertCodeToRes(float Code, float FullScale)
+{
+  return (Code * GaugeConfig::SeriesResistor) / (FullScale - Code);
+}
+
+float convertAdcToRes(uint16_t Code, unsigned char AdcBits);
+
+float convertResToTemp(float Res);
+
+void convertAdcToResBatch(const uint16_t * Codes, float * Res, unsigned long Count, unsigned char AdcBits);
+
+void convertResToTempBatch(const float * Res, float * Temps, unsigned long Count);
+
+void convertAdcToTempBatch(const uint16_t * Codes, float * Res, float * Temps, unsigned long Count, unsigned char AdcBits);
+
+
+// convertAdcToRes() for a resolution known at build time, so the full scale folds to a constant
+template <unsigned char AdcBits>
+inline float convertAdcToRes(uint16_t Code)
+{
+  return convertCodeToRes(Code, float(1UL << AdcBits));
+}
+
+template <unsigned int Len>
+void boxcarInit(FIXED_BOXCAR_FILTER<Len> * Filter, int Initial)
+{
+  Filter->It = 0;
+  Filter->Sum = 0;
+
+  for (unsigned int i = 0; i < Len; i++)
+  {
+    Filter->Samples[i] = Initial;
+    Filter->Sum += Initial;
+  }
+}
+
+template <unsigned int Len>
+int boxcarPush(FIXED_BOXCAR_FILTER<Len> * Filter, int Sample)
+{
+  Filter->Sum -= Filter->Samples[Filter->It];
+  Filter->Samples[Filter->It] = Sample;
+  Filter->Sum += Sample;
+
+  if (++Filter->It == Len)
+  {
+    Filter->It = 0;
+  }
+
+  return int(Filter->Sum / long(Len));
+}
+
+#endif
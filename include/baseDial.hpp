@@ -0,0 +1,54 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   baseDial.hpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Declarations for the dial gauge geometry: fixed-point sin/cos from a
+*   flash table, integer line rasterization and needle motion
+*
+*   Angles are in 1/DIAL_ANGLE_SCALE degree, counterclockwise from the
+*   +x axis with y pointing up, so 0 is 3 o'clock and 90 * 16 is 12 o'clock.
+*
+*/
+
+#ifndef BASE_DIAL_HPP
+#define BASE_DIAL_HPP
+
+#include <stdint.h>
+#include "basePgm.hpp"
+
+#define DIAL_ANGLE_SCALE      16                  // Angle units per degree
+#define DIAL_TRIG_SHIFT       14                  // dialSin() and dialCos() are Q14
+#define DIAL_DEG(d)           ((int16_t)((d) * DIAL_ANGLE_SCALE))
+// A step of elapsed ms moves the needle elapsed / DIAL_EASE_MS of the remaining distance, at
+// least one angle unit, and a step of DIAL_EASE_MS or longer lands on the target
+#define DIAL_EASE_MS          120
+
+// Called for every pixel of a rasterized line
+typedef void (*DIAL_PLOT_FN)(int16_t X, int16_t Y, void * Ctx);
+
+// Shown needle angle, eased towards the latest reading
+typedef struct _DIAL_NEEDLE
+{
+  int16_t Angle;
+  int16_t Target;
+  unsigned long LastMs;
+} DIAL_NEEDLE, *PTR_DIAL_NEEDLE;
+
+int16_t dialSin(int16_t Angle);
+
+int16_t dialCos(int16_t Angle);
+
+void dialPoint(int16_t Cx, int16_t Cy, int16_t Radius, int16_t Angle, int16_t * X, int16_t * Y);
+
+void dialRasterLine(int16_t X0, int16_t Y0, int16_t X1, int16_t Y1, DIAL_PLOT_FN Plot, void * Ctx);
+
+int16_t dialValueToAngle(int Value, int Min, int Max, int16_t StartAngle, int16_t SweepAngle);
+
+void dialNeedleInit(PTR_DIAL_NEEDLE Needle, int16_t Angle, unsigned long NowMs);
+
+void dialNeedleSetTarget(PTR_DIAL_NEEDLE Needle, int16_t Target);
+
+bool dialNeedleStep(PTR_DIAL_NEEDLE Needle, unsigned long NowMs);
+
+#endif
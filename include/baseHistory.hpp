@@ -0,0 +1,78 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   baseHistory.hpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Declarations for the tiered temperature history store.
+*
+*   Samples are folded into per-second buckets, which downsample into
+*   per-10-second buckets, which downsample into per-minute buckets.
+*   RAM cost is fixed at compile time by the HIST_TIER*_LEN values.
+*
+*/
+
+#ifndef BASE_HISTORY_HPP
+#define BASE_HISTORY_HPP
+
+#include <stdint.h>
+
+#define HIST_TIER0_SEC_PER_BUCKET   1
+#define HIST_TIER1_SEC_PER_BUCKET   10
+#define HIST_TIER2_SEC_PER_BUCKET   60
+
+#ifdef __AVR__
+  #define HIST_TIER0_LEN            20      // 20 s
+  #define HIST_TIER1_LEN            18      // 3 min
+  #define HIST_TIER2_LEN            30      // 30 min
+#else
+  #define HIST_TIER0_LEN            60      // 1 min
+  #define HIST_TIER1_LEN            60      // 10 min
+  #define HIST_TIER2_LEN            120     // 2 hours
+#endif
+
+typedef enum _HIST_TIER_NUM
+{
+  HIST_TIER_SECONDS       = 0,
+  HIST_TIER_10_SECONDS    = 1,
+  HIST_TIER_MINUTES       = 2,
+  HIST_TIER_MAX
+} HIST_TIER_NUM, *PTR_HIST_TIER_NUM;
+
+typedef enum _HIST_STATUS
+{
+  HIST_STATUS_SUCCESS         = 0,
+  HIST_STATUS_NO_DATA         = 1,
+  HIST_STATUS_INVALID_PARAM   = 2,
+  HIST_STATUS_MAX
+} HIST_STATUS, *PTR_HIST_STATUS;
+
+// One closed bucket. Mean is the mean of every raw sample that went into it, child buckets included.
+typedef struct _HIST_BUCKET
+{
+  int16_t Min;
+  int16_t Max;
+  int16_t Mean;
+} HIST_BUCKET, *PTR_HIST_BUCKET;
+
+// Result of a range query
+typedef struct _HIST_STATS
+{
+  int16_t Min;
+  int16_t Max;
+  int16_t Mean;
+  unsigned long Seconds;      // Span actually covered by the result
+} HIST_STATS, *PTR_HIST_STATS;
+
+void historyInit();
+
+void historyAddSample(int Temp, unsigned long NowMs);
+
+HIST_STATUS historyGetStats(unsigned long Seconds, PTR_HIST_STATS Stats);
+
+HIST_STATUS historyGetBucket(HIST_TIER_NUM Tier, unsigned char Age, PTR_HIST_BUCKET Bucket);
+
+unsigned char historyGetNumBuckets(HIST_TIER_NUM Tier);
+
+unsigned long historyGetNumClosed(HIST_TIER_NUM Tier);
+
+#endif
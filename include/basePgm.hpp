@@ -0,0 +1,32 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   basePgm.hpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Flash table access for the base modules. On the boards it is the
+*   core's avr/pgmspace.h, which the SAMD core also provides. On the
+*   host flash and RAM are one address space, so PROGMEM is empty and
+*   the reads are plain loads.
+*
+*/
+
+#ifndef BASE_PGM_HPP
+#define BASE_PGM_HPP
+
+#include <stdint.h>
+
+#ifdef ARDUINO
+  #include <avr/pgmspace.h>
+#else
+  #ifndef PROGMEM
+    #define PROGMEM
+  #endif
+  #ifndef pgm_read_byte
+    #define pgm_read_byte(Addr)   (*(const uint8_t *)(Addr))
+  #endif
+  #ifndef pgm_read_word
+    #define pgm_read_word(Addr)   (*(const uint16_t *)(Addr))
+  #endif
+#endif
+
+#endif
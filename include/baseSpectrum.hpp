@@ -0,0 +1,53 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   baseSpectrum.hpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Declarations for finding the dominant noise frequencies in a burst
+*   of raw ADC samples
+*
+*   The burst is cut into SPECTRUM_SEG_LEN sample segments. Each one is
+*   Hann windowed and run through a fixed-point Goertzel filter for every
+*   bin k = 1..SPECTRUM_NUM_BINS, at k * rate / SPECTRUM_SEG_LEN Hz. The
+*   power per bin is averaged over the segments, so bins are as wide as
+*   their spacing and a tone between two bins still shows up. No Arduino
+*   dependencies, tools/spectrumBench.cpp runs the same code on the host.
+*
+*/
+
+#ifndef BASE_SPECTRUM_HPP
+#define BASE_SPECTRUM_HPP
+
+#include <stdint.h>
+
+#ifdef __AVR__
+  #define SPECTRUM_NUM_BINS     32
+#else
+  #define SPECTRUM_NUM_BINS     64
+#endif
+
+#define SPECTRUM_SEG_LEN        (2 * SPECTRUM_NUM_BINS)
+#define SPECTRUM_COEFF_SHIFT    14          // Goertzel coefficients are Q14
+#define SPECTRUM_WINDOW_SHIFT   15          // Window is Q15
+#define SPECTRUM_MAX_PEAKS      5
+
+typedef enum _SPECTRUM_STATUS
+{
+  SPECTRUM_STATUS_SUCCESS         = 0,
+  SPECTRUM_STATUS_INVALID_PARAM   = 1,
+  SPECTRUM_STATUS_MAX
+} SPECTRUM_STATUS, *PTR_SPECTRUM_STATUS;
+
+typedef struct _SPECTRUM_PEAK
+{
+  float FreqHz;
+  float Amplitude;          // Sine amplitude in ADC codes
+} SPECTRUM_PEAK, *PTR_SPECTRUM_PEAK;
+
+void spectrumInit();
+
+SPECTRUM_STATUS spectrumAnalyze(const int16_t * Samples, unsigned int Count, float * Amplitude);
+
+unsigned char spectrumFindPeaks(const float * Amplitude, float RateHz, PTR_SPECTRUM_PEAK Peaks, unsigned char MaxPeaks);
+
+#endif
@@ -0,0 +1,63 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   baseTempHist.hpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Declarations for the time-at-temperature histogram. Counts how many
+*   seconds the oil has spent in each TEMPHIST_WIDTH_F wide band. The
+*   first and last bands also hold everything below and above the
+*   covered range.
+*
+*   The live counts are kept in a TEMPHIST_RECORD so they can be saved
+*   and dumped without a copy.
+*
+*/
+
+#ifndef BASE_TEMP_HIST_HPP
+#define BASE_TEMP_HIST_HPP
+
+#include <stdint.h>
+
+#define TEMPHIST_NUM_BUCKETS    16
+#define TEMPHIST_MIN_F          60          // Low edge of bucket 1, bucket 0 holds everything below
+#define TEMPHIST_WIDTH_F        20          // 60F - 360F, last bucket holds everything above
+#define TEMPHIST_MAX_GAP_MS     5000        // Longer gaps between samples aren't counted
+
+#define TEMPHIST_MAGIC          0x5448      // "TH"
+#define TEMPHIST_VERSION        1
+
+typedef enum _TEMPHIST_STATUS
+{
+  TEMPHIST_STATUS_SUCCESS         = 0,
+  TEMPHIST_STATUS_INVALID_RECORD  = 1,
+  TEMPHIST_STATUS_INVALID_PARAM   = 2,
+  TEMPHIST_STATUS_MAX
+} TEMPHIST_STATUS, *PTR_TEMPHIST_STATUS;
+
+// Saved to flash / EEPROM and sent over serial as-is. Little-endian, no padding.
+typedef struct _TEMPHIST_RECORD
+{
+  uint16_t Magic;
+  uint8_t Version;
+  uint8_t NumBuckets;
+  int16_t MinF;
+  uint16_t WidthF;
+  uint32_t Seconds[TEMPHIST_NUM_BUCKETS];
+  uint32_t Check;
+} TEMPHIST_RECORD, *PTR_TEMPHIST_RECORD;
+
+void tempHistInit();
+
+void tempHistAddSample(int Temp, unsigned long NowMs);
+
+uint32_t tempHistGetSeconds(unsigned char Bucket);
+
+int tempHistGetBucketLowF(unsigned char Bucket);
+
+uint32_t tempHistGetTotalSeconds();
+
+const TEMPHIST_RECORD * tempHistSeal();
+
+TEMPHIST_STATUS tempHistRestore(const TEMPHIST_RECORD * Record);
+
+#endif
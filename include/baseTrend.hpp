@@ -0,0 +1,51 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   baseTrend.hpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Declarations for the rate-of-change estimator and the predictive
+*   over-temperature alarm
+*
+*/
+
+#ifndef BASE_TREND_HPP
+#define BASE_TREND_HPP
+
+#include <stdint.h>
+#include "baseHistory.hpp"
+
+#ifdef __AVR__
+  #define TREND_WINDOW_SEC      16      // Per-second history buckets in the least-squares window
+#else
+  #define TREND_WINDOW_SEC      20
+#endif
+
+#if TREND_WINDOW_SEC >= HIST_TIER0_LEN
+  #error "TREND_WINDOW_SEC must be shorter than the per-second history tier"
+#endif
+
+#define TREND_ALARM_TEMP_F      280     // Alarm when the oil is predicted to reach this temperature
+#define TREND_ALARM_HYST_F      10      // Alarm clears once prediction drops this far below the threshold
+#define TREND_HORIZON_SEC       30      // How far ahead the prediction looks
+
+typedef enum _TREND_ALARM_STATE
+{
+  TREND_ALARM_CLEAR       = 0,
+  TREND_ALARM_PREDICTED   = 1,      // Not over temperature yet, but will be within TREND_HORIZON_SEC
+  TREND_ALARM_OVER_TEMP   = 2,      // Already at or above TREND_ALARM_TEMP_F
+  TREND_ALARM_MAX
+} TREND_ALARM_STATE, *PTR_TREND_ALARM_STATE;
+
+void trendInit();
+
+TREND_ALARM_STATE trendAddSample(int Temp, unsigned long NowMs);
+
+float trendGetSlope();
+
+int trendGetPrediction();
+
+TREND_ALARM_STATE trendGetAlarm();
+
+unsigned long trendGetAlarmSetMs();
+
+#endif
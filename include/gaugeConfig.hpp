@@ -0,0 +1,63 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   gaugeConfig.hpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Build-time configuration of the gauge, one type per PlatformIO env
+*
+*   Each env picks its type with -D GAUGE_CONFIG_<NAME> in platformio.ini.
+*   Without one the board decides. Every member is constexpr, so sizes and
+*   constants fold into the code that uses them, and code behind a
+*   feature that is off is selected away with FeatureTag overloads. No
+*   Arduino dependencies, the host tools build with the default type.
+*
+*   Display driver options stay DISPLAY_* build flags, they choose which
+*   classes and headers are compiled at all.
+*
+*/
+
+#ifndef GAUGE_CONFIG_HPP
+#define GAUGE_CONFIG_HPP
+
+// Picks an overload at compile time: f(FeatureTag<GaugeConfig::Debug>())
+template <bool Enabled>
+struct FeatureTag
+{
+};
+
+typedef FeatureTag<true>  FEATURE_ON;
+typedef FeatureTag<false> FEATURE_OFF;
+
+struct XiaoGaugeConfig
+{
+  static constexpr unsigned int NumSamples = 120;     // Samples in the rolling averages
+  static constexpr unsigned char AdcBits = 12;
+  static constexpr float RefmV = 3320.0f;             // ADC reference, measured
+  static constexpr float SeriesResistor = 150.0f;     // Ohms, top of the voltage divider
+
+  static constexpr bool Debug = false;                // Screen and timing self-test instead of the gauge
+  static constexpr bool NumbersDebug = false;         // Count on screen during the self-test
+  static constexpr bool DataCollection = true;        // Averaged resistance and pin voltage on the gauge
+  static constexpr bool ChibisDebug = false;          // Print chibisDrawPixel() arguments when it fails
+};
+
+struct XiaoDebugGaugeConfig : XiaoGaugeConfig
+{
+  static constexpr bool Debug = true;
+};
+
+struct NanoGaugeConfig : XiaoGaugeConfig
+{
+  static constexpr unsigned int NumSamples = 32;      // 2 KB of SRAM has to hold the display path too
+  static constexpr unsigned char AdcBits = 10;
+};
+
+#if defined(GAUGE_CONFIG_XIAO_DEBUG)
+  typedef XiaoDebugGaugeConfig GaugeConfig;
+#elif defined(GAUGE_CONFIG_NANO) || (defined(__AVR__) && !defined(GAUGE_CONFIG_XIAO))
+  typedef NanoGaugeConfig GaugeConfig;
+#else
+  typedef XiaoGaugeConfig GaugeConfig;
+#endif
+
+#endif
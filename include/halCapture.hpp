@@ -0,0 +1,53 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   halCapture.hpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Declarations for streaming the live OLED framebuffer, and other
+*   binary records, over the serial port. Viewed with
+*   tools/screenCapture.py.
+*
+*   Record layout:
+*     0xA5 0x5A     sync
+*     Type          CAPTURE_TYPE_*
+*     Seq           increments by one per record
+*     Len           payload length, uint16 little-endian
+*     Payload
+*     Check         XOR of all payload bytes
+*
+*   KEYFRAME payload is the raw SSD1306 buffer (8 pages x 128 columns).
+*   DELTA payload is the buffer XORed with the previous record's frame,
+*   run-length encoded as (Value, Reps) pairs like ENCODED_PAIR.
+*   TEMP_HIST payload is a TEMPHIST_RECORD, see baseTempHist.hpp.
+*
+*/
+
+#ifndef HAL_CAPTURE_HPP
+#define HAL_CAPTURE_HPP
+
+#define CAPTURE_SYNC_0              0xA5
+#define CAPTURE_SYNC_1              0x5A
+#define CAPTURE_HEADER_LEN          6
+#define CAPTURE_KEYFRAME_INTERVAL   32      // Send a keyframe at least this often so a late viewer can sync
+
+typedef enum _CAPTURE_TYPE
+{
+  CAPTURE_TYPE_KEYFRAME   = 0,
+  CAPTURE_TYPE_DELTA      = 1,
+  CAPTURE_TYPE_TEMP_HIST  = 2,
+  CAPTURE_TYPE_MAX
+} CAPTURE_TYPE, *PTR_CAPTURE_TYPE;
+
+void captureWriteRecord(CAPTURE_TYPE Type, const unsigned char * Payload, unsigned int Len);
+
+bool captureRequest(bool Continuous);
+
+void captureStop();
+
+bool captureIsStreaming();
+
+void captureService();
+
+void captureFrameSent();
+
+#endif
@@ -14,20 +14,156 @@
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
 #include "wiring_private.h"
+#include "halSsd1306.hpp"
+#include "baseDial.hpp"
 
 #define SCREEN_WIDTH      128
 #define SCREEN_HEIGHT     64
 
 #define OLED_RESET -1
 
-extern Adafruit_SSD1306 display;
+// Second panel on its own SERCOM I2C bus (SAMD only). Enable with -D DISPLAY_DUAL.
+// SERCOM0 is routed to D1 (PA04, SDA) and D9 (PA05, SCL) through the alternate pin mux.
+// On the XIAO, SERCOM0 is also the hardware SPI port and D9 is its MISO pin, so the
+// second panel and the SPI transport can't be built together.
+#if defined(DISPLAY_DUAL) && !defined(__AVR__)
+  #ifdef SSD1306_TRANSPORT_SPI
+    #error "DISPLAY_DUAL puts the second panel on SERCOM0, which SSD1306_TRANSPORT_SPI needs for SPI"
+  #endif
+
+  #define DISPLAY2_SERCOM         sercom0
+  #define DISPLAY2_SERCOM_REGS    SERCOM0     // Registers of DISPLAY2_SERCOM, for the interrupt-driven flush
+  #define DISPLAY2_SDA_PIN        1
+  #define DISPLAY2_SCL_PIN        9
+  #define DISPLAY2_I2C_CLOCK_HZ   400000      // SSD1306 is rated for Fast-mode, 400 kHz
+
+  #ifndef DISPLAY2_MIRROR
+    #define DISPLAY2_MIRROR       1           // 1 = copy of the main panel, 0 = drawn by displayRender2()
+  #endif
+#endif
+
+// Draws one frame. Called once per frame with a full framebuffer, or once per
+// 8-row page in DISPLAY_PAGE_MODE, so it must not have side effects (sampling etc.)
+// and must set its own cursor, text size and color every call.
+typedef void (*DISPLAY_DRAW_FN)(Adafruit_GFX & Gfx);
+
+// Part of the screen redrawn every frame by a layout's Dynamic function.
+// Rows are widened to whole 8-row pages.
+typedef struct _DISPLAY_REGION
+{
+  int16_t X;
+  int16_t Y;
+  int16_t W;
+  int16_t H;
+} DISPLAY_REGION, *PTR_DISPLAY_REGION;
+
+// Screen drawn in two layers. Background is drawn once and cached. Each frame the
+// regions are restored from the cache and Dynamic draws onto them, so Dynamic must
+// stay inside its regions.
+typedef struct _DISPLAY_LAYOUT
+{
+  DISPLAY_DRAW_FN Background;
+  DISPLAY_DRAW_FN Dynamic;
+  const DISPLAY_REGION * Regions;
+  unsigned char NumRegions;
+} DISPLAY_LAYOUT, *PTR_DISPLAY_LAYOUT;
+
+// Dial gauge. Layout.Background draws the face and Layout.Dynamic draws whatever
+// sits in Layout.Regions, e.g. a digital readout. The needle is drawn by this
+// module from NeedleStart to NeedleEnd pixels out from the center.
+typedef struct _DISPLAY_DIAL
+{
+  DISPLAY_LAYOUT Layout;
+  int16_t CenterX;
+  int16_t CenterY;
+  int16_t NeedleStart;
+  int16_t NeedleEnd;
+} DISPLAY_DIAL, *PTR_DISPLAY_DIAL;
+
+// Effects driven by panel commands only, no pixel data is sent. Run by
+// displayEffectsService(), one effect at a time.
+typedef enum _DISPLAY_EFFECT
+{
+  DISPLAY_EFFECT_NONE         = 0,
+  DISPLAY_EFFECT_BLINK        = 1,    // Panel off/on, Count blinks
+  DISPLAY_EFFECT_INVERT_FLASH = 2,    // Invert/normal, Count flashes
+  DISPLAY_EFFECT_FADE_OUT     = 3,    // Contrast ramp down, leaves the panel off
+  DISPLAY_EFFECT_FADE_IN      = 4,    // Panel on, contrast ramp up
+  DISPLAY_EFFECT_WIPE_LEFT    = 5,    // Hardware scroll while fading out, next frame turns it back on
+  DISPLAY_EFFECT_WIPE_RIGHT   = 6,
+  DISPLAY_EFFECT_MAX
+} DISPLAY_EFFECT, *PTR_DISPLAY_EFFECT;
+
+#if defined(SSD1306_TRANSPORT_SPI) && !defined(DISPLAY_PAGE_MODE) && !defined(DISPLAY_LEAN_DRIVER)
+  #error "The SPI transport needs DISPLAY_LEAN_DRIVER or DISPLAY_PAGE_MODE, the Adafruit path is I2C only"
+#endif
+
+#ifdef DISPLAY_PAGE_MODE
+// Canvas covering a single 128x8 page of the screen. Pixels outside the page are dropped.
+class PageCanvas : public Adafruit_GFX
+{
+public:
+    PageCanvas();
+
+    void setPage(unsigned char Page);
+    unsigned char * getBuffer();
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color);
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void fillScreen(uint16_t color);
+
+private:
+    unsigned char buffer[SSD1306_PAGE_BYTES];
+    int16_t pageY0;
+};
+#else
+  #ifdef DISPLAY_LEAN_DRIVER
+    typedef LeanSSD1306 DisplayDriver;        // In-tree driver, static framebuffer and windowed flushes
+  #else
+    typedef Adafruit_SSD1306 DisplayDriver;
+  #endif
+
+extern DisplayDriver display;
+#endif
+
+#ifdef DISPLAY2_SERCOM
+extern Adafruit_SSD1306 display2;
+#endif
 
 void displayInit();
 
+void displayRender(DISPLAY_DRAW_FN Draw);
+
+void displayRender2(DISPLAY_DRAW_FN Draw);
+
+void displayRenderLayered(const DISPLAY_LAYOUT * Layout);
+
+void displayRenderDial(const DISPLAY_DIAL * Dial, int16_t Angle);
+
+void displayInvalidate();
+
+void displayEffectStart(DISPLAY_EFFECT Effect, unsigned int PeriodMs, unsigned char Count);
+
+void displayEffectStop();
+
+bool displayEffectActive();
+
+void displayEffectsService(unsigned long NowMs);
+
+float displayGetFps();
+
+void displayBenchmark(unsigned char Frames);
+
+void displayBenchmarkLayered(const DISPLAY_LAYOUT * Layout, unsigned char Frames);
+
+void displayBenchmarkDial(const DISPLAY_DIAL * Dial, int16_t Angle0, int16_t Angle1, unsigned char Frames);
+
 void displayPrintHappyChibi();
 
 void displayBlinkChibi(int TimeSeconds);
 
+void displayPrintAlert(int Temp, float SlopePerSec);
+
 void displaySerialDebugPrint(const unsigned char * Image);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,71 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   halGray.hpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Declarations for showing 4-level grayscale images on the 1bpp panel
+*   by temporal dithering
+*
+*   A gray image is two planes in SSD1306 page layout, level = 2*High + Low.
+*   Each cycle is three full-frame subframes:
+*     subframe 0: High | Low     on for levels 1, 2, 3
+*     subframe 1: High           on for levels 2, 3
+*     subframe 2: High & Low     on for level 3
+*   so a pixel is lit for 0, 1, 2 or 3 thirds of the cycle. Build the
+*   planes with tools/grayPlanes.py.
+*
+*   Needs the raw transport of the in-tree driver, so it is only available
+*   with DISPLAY_LEAN_DRIVER or DISPLAY_PAGE_MODE. Flicker depends on the bus,
+*   a full frame is ~1 KB:
+*     I2C 400 kHz   ~35 subframes/s, ~12 Hz cycle, strong flicker
+*     I2C 1 MHz     ~85 subframes/s, ~28 Hz cycle, visible flicker
+*     SPI 8 MHz     ~700 subframes/s, well above what the eye can see
+*
+*/
+
+#ifndef HAL_GRAY_HPP
+#define HAL_GRAY_HPP
+
+#include "halSsd1306.hpp"
+
+#if defined(DISPLAY_LEAN_DRIVER) || defined(DISPLAY_PAGE_MODE)
+  #define GRAY_SUPPORTED            1
+#else
+  #define GRAY_SUPPORTED            0
+#endif
+
+#define GRAY_NUM_SUBFRAMES          3
+#define GRAY_CALIBRATE_SUBFRAMES    (3 * GRAY_NUM_SUBFRAMES)    // Unpaced subframes used to pick the period
+#define GRAY_PERIOD_MARGIN_SHIFT    3                           // Period = slowest calibration subframe + 1/8
+
+typedef enum _GRAY_STATUS
+{
+  GRAY_STATUS_SUCCESS         = 0,
+  GRAY_STATUS_UNSUPPORTED     = 1,
+  GRAY_STATUS_INVALID_PARAM   = 2,
+  GRAY_STATUS_MAX
+} GRAY_STATUS, *PTR_GRAY_STATUS;
+
+// Both planes are SSD1306_BUFFER_BYTES long and read with pgm_read_byte(), so
+// on AVR they must be in PROGMEM
+typedef struct _GRAY_IMAGE
+{
+  const unsigned char * High;
+  const unsigned char * Low;
+} GRAY_IMAGE, *PTR_GRAY_IMAGE;
+
+// Measured over the paced part of the run
+typedef struct _GRAY_STATS
+{
+  float Fps;                    // Subframes per second
+  float CycleHz;                // Full gray cycles per second, the flicker frequency
+  unsigned long PeriodUs;       // Target subframe period picked by calibration
+  unsigned long MinPeriodUs;    // Shortest and longest measured subframe period
+  unsigned long MaxPeriodUs;
+  float JitterPct;              // (Max - Min) / target period
+  unsigned int LateFrames;      // Subframes that started after their deadline
+} GRAY_STATS, *PTR_GRAY_STATS;
+
+GRAY_STATUS grayShow(const GRAY_IMAGE * Image, unsigned long DurationMs, PTR_GRAY_STATS Stats);
+
+#endif
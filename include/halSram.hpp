@@ -0,0 +1,39 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   halSram.hpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Declarations for checking how much of the nano's 2 KB of SRAM is
+*   left for the stack
+*
+*   Static budget of the page-mode nano build, tallied by hand from
+*   the globals with AVR sizes (2 byte int and pointer, 4 byte double).
+*   Not read from the .data/.bss of a real avr-gcc build, so treat it
+*   as an estimate and check with avr-size when one is at hand:
+*     - history buckets, 68 x 6 B                    408 B
+*     - history tiers and state                      ~80 B
+*     - PageCanvas, 128 B page plus the GFX object  ~155 B
+*     - resistance average, 32 floats               ~134 B
+*     - temperature boxcar, 32 ints                   70 B
+*     - time-at-temperature record                    76 B
+*     - spectrum window                               66 B
+*     - trend, alert, effect and dial state          ~70 B
+*     - alert regions and layout, const but in RAM   ~20 B
+*     - Wire and twi buffers                        ~170 B
+*     - Serial rx/tx rings                          ~157 B
+*     - core timers                                   ~9 B
+*   About 1.4 KB, leaving ~600 B for the stack and the heap. The
+*   resistance and temperature tables, the dial sine table, the
+*   chibis and the SSD1306 init sequence are all in PROGMEM. The hinge
+*   table of baseConvert.cpp is not built on AVR.
+*
+*/
+
+#ifndef HAL_SRAM_HPP
+#define HAL_SRAM_HPP
+
+#ifdef __AVR__
+unsigned int sramGetFree();
+#endif
+
+#endif
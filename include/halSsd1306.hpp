@@ -0,0 +1,147 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   halSsd1306.hpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Declarations for the in-tree SSD1306 driver: raw command/data
+*   transfers and a lean framebuffer driver with windowed flushes.
+*
+*   The transport is picked at compile time:
+*     default                   I2C at SSD1306_I2C_CLOCK_HZ
+*     -D SSD1306_TRANSPORT_SPI  hardware SPI at SSD1306_SPI_CLOCK_HZ
+*
+*/
+
+#ifndef HAL_SSD1306_HPP
+#define HAL_SSD1306_HPP
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+#define SSD1306_I2C_ADDR            0x3C
+
+// Panel supply, same values as Adafruit_SSD1306's begin() takes
+#ifndef SSD1306_EXTERNALVCC
+  #define SSD1306_EXTERNALVCC       0x01    // VCC from an external supply, charge pump off
+#endif
+#ifndef SSD1306_SWITCHCAPVCC
+  #define SSD1306_SWITCHCAPVCC      0x02    // VCC from the internal charge pump
+#endif
+
+#ifndef SSD1306_I2C_CLOCK_HZ
+  #define SSD1306_I2C_CLOCK_HZ      400000
+#endif
+
+#ifndef SSD1306_SPI_CLOCK_HZ
+  #define SSD1306_SPI_CLOCK_HZ      8000000
+#endif
+
+// SPI variant of the panel. MOSI and SCK are the board's hardware SPI pins. The
+// defaults stay clear of Serial, I2C, SPI, the sensor and the second panel's bus.
+#ifdef __AVR__
+  #ifndef SSD1306_SPI_CS_PIN
+    #define SSD1306_SPI_CS_PIN      10      // SS, has to be an output for SPI master mode anyway
+  #endif
+  #ifndef SSD1306_SPI_DC_PIN
+    #define SSD1306_SPI_DC_PIN      9
+  #endif
+  #ifndef SSD1306_SPI_RST_PIN
+    #define SSD1306_SPI_RST_PIN     8
+  #endif
+#else
+  #ifndef SSD1306_SPI_CS_PIN
+    #define SSD1306_SPI_CS_PIN      2
+  #endif
+  #ifndef SSD1306_SPI_DC_PIN
+    #define SSD1306_SPI_DC_PIN      3
+  #endif
+  #ifndef SSD1306_SPI_RST_PIN
+    #define SSD1306_SPI_RST_PIN     0
+  #endif
+#endif
+
+#define SSD1306_WIDTH               128
+#define SSD1306_HEIGHT              64
+#define SSD1306_NUM_PAGES           8       // 64 rows / 8 rows per page
+#define SSD1306_PAGE_BYTES          128     // One byte per column, LSB = top row of the page
+#define SSD1306_BUFFER_BYTES        (SSD1306_PAGE_BYTES * SSD1306_NUM_PAGES)
+
+// Pixel colors, same values as the Adafruit driver
+#ifndef SSD1306_WHITE
+  #define SSD1306_BLACK             0
+  #define SSD1306_WHITE             1
+  #define SSD1306_INVERSE           2
+#endif
+
+// Control bytes sent after the I2C address
+#define SSD1306_CTRL_COMMAND        0x00
+#define SSD1306_CTRL_DATA           0x40
+
+// Commands
+#define SSD1306_CMD_SET_CONTRAST    0x81
+#define SSD1306_CMD_NORMAL          0xA6
+#define SSD1306_CMD_INVERT          0xA7
+#define SSD1306_CMD_DISPLAY_OFF     0xAE
+#define SSD1306_CMD_DISPLAY_ON      0xAF
+#define SSD1306_CMD_SET_COL_ADDR    0x21
+#define SSD1306_CMD_SET_PAGE_ADDR   0x22
+#define SSD1306_CMD_SET_CLOCK_DIV   0xD5    // High nibble = oscillator frequency, low nibble = divide ratio - 1
+#define SSD1306_CLOCK_DIV_DEFAULT   0x80
+#define SSD1306_CLOCK_DIV_FASTEST   0xF0
+#define SSD1306_CMD_SCROLL_RIGHT    0x26    // Followed by 0x00, start page, interval, end page, 0x00, 0xFF
+#define SSD1306_CMD_SCROLL_LEFT     0x27
+#define SSD1306_CMD_SCROLL_OFF      0x2E    // GDDRAM must be rewritten after scrolling stops
+#define SSD1306_CMD_SCROLL_ON       0x2F
+#define SSD1306_SCROLL_2_FRAMES     0x07    // Fastest scroll interval
+
+#define SSD1306_CONTRAST_NORMAL     0xCF
+#define SSD1306_CONTRAST_DIM        0x00
+
+void ssd1306Init(unsigned char VccState, unsigned char Addr);
+
+void ssd1306Command(unsigned char Cmd);
+
+void ssd1306SetWindow(unsigned char Col0, unsigned char Col1, unsigned char Page0, unsigned char Page1);
+
+void ssd1306WriteData(const unsigned char * Data, unsigned int Len);
+
+
+#ifdef DISPLAY_LEAN_DRIVER
+/***********************************************************************************
+ * LeanSSD1306
+ *  Framebuffer driver with the subset of the Adafruit_SSD1306 API this firmware
+ *    uses. The framebuffer is static, nothing is allocated in begin(), and
+ *    display() only sends the rectangle of pages and columns drawn since the
+ *    last flush.
+ ***********************************************************************************/
+class LeanSSD1306 : public Adafruit_GFX
+{
+public:
+    LeanSSD1306();
+
+    bool begin(uint8_t VccState = SSD1306_SWITCHCAPVCC, uint8_t Addr = SSD1306_I2C_ADDR);
+    void display();
+    void clearDisplay();
+    unsigned char * getBuffer();
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color);
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    void fillScreen(uint16_t color);
+
+    void markDirty(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+    void markAllDirty();
+    void clearDirty();
+
+    void invertDisplay(bool i);
+    void dim(bool dim);
+    void ssd1306_command(uint8_t c);
+
+private:
+    int16_t dirtyX0, dirtyX1;           // Inclusive column range, X0 > X1 when nothing is dirty
+    unsigned char dirtyPage0, dirtyPage1;
+};
+#endif
+
+#endif
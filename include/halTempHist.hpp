@@ -0,0 +1,61 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   halTempHist.hpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Declarations for saving the time-at-temperature histogram across
+*   power cycles and dumping it over serial
+*
+*   SAMD21 has no EEPROM, the record goes into a flash row through the
+*   FlashStorage library. Rows are good for ~10k erase cycles, so saves
+*   are far apart. The rows are erased when new firmware is uploaded.
+*
+*   Each power-up saves early, so a short drive isn't lost, then settles
+*   on the interval. Saves only happen when the histogram changed. On the
+*   SAMD21 that is at 2 and 10 min of running, then every 30 min. With
+*   the saves split over the two slots below:
+*     - long runs use 1 cycle per row per hour, 10k = ~10000 h of running
+*     - a trip costs at most 1 extra cycle per row, 30 min trips = 10000 trips
+*   whichever comes first.
+*
+*   The nano keeps it in EEPROM, which only rewrites changed bytes and
+*   is good for ~100k cycles. It saves at 1 min, then every 5 min.
+*
+*   Saves alternate between two slots, each a record followed by a
+*   sequence number. Power cut during a save, at ignition-off say,
+*   leaves a record that fails its check, and the other slot still
+*   holds the save before it. Each slot takes half the writes.
+*
+*/
+
+#ifndef HAL_TEMP_HIST_HPP
+#define HAL_TEMP_HIST_HPP
+
+#include "baseTempHist.hpp"
+
+#define TEMPHIST_NUM_SLOTS            2
+
+// One save. Seq comes after the record so EEPROM.put() writes it last, a save cut short
+// leaves the slot's old sequence number or a record that fails its check.
+typedef struct _TEMPHIST_SLOT
+{
+  TEMPHIST_RECORD Record;
+  uint32_t Seq;                 // Incremented per save, the higher valid slot is the newest
+} TEMPHIST_SLOT, *PTR_TEMPHIST_SLOT;
+
+#ifdef __AVR__
+  #define TEMPHIST_SAVE_INTERVAL_MS   (5UL * 60 * 1000)       // 5 min
+  #define TEMPHIST_EEPROM_ADDR        0                       // Slot 0, slot 1 follows it
+#else
+  #define TEMPHIST_SAVE_INTERVAL_MS   (30UL * 60 * 1000)      // 30 min
+#endif
+
+void tempHistStoreInit();
+
+void tempHistStoreService(unsigned long NowMs);
+
+void tempHistStoreSave();
+
+void tempHistDump();
+
+#endif
@@ -11,21 +11,43 @@
 #define HAL_THERMISTOR_HPP
 
 #include <Wire.h>
+#include "baseConvert.hpp"
+#include "baseSpectrum.hpp"
 
-#define NUM_RES_VALUES    16      // Number of resistance and temperature values stored for reference
-#define NUM_SAMPLES       120      // Number of samples stored and used to calculate rolling averages
-
-
+// Sample counts, ADC resolution and the divider resistor come from GaugeConfig
 #ifdef __AVR__
   #define SENSOR_PIN        A0
 #else
-  #define REF_mV            3320.0
   #define SENSOR_PIN        7
 #endif
 
-// PARALLEL ARRAYS
-extern const unsigned int RESISTANCE_VALS[];    // Stored resistance values of thermistor at temps in TEMP_VALS 
-extern const unsigned int TEMP_VALS[];          // Stored temperature values at each resistance value in RESISTANCE_VALS
+// Burst capture for noise analysis. The buffers only live on the stack while a burst runs,
+// on AVR the report first checks that they fit.
+#ifdef __AVR__
+  #define BURST_NUM_SAMPLES   256      // 512 bytes of stack, 4 segments of SPECTRUM_SEG_LEN
+#else
+  #define BURST_NUM_SAMPLES   4096     // 8 KB of stack, 32 segments of SPECTRUM_SEG_LEN
+#endif
+
+// Samples and spectrum on the stack during a burst, plus room for the calls below it
+#define BURST_STACK_BYTES   (BURST_NUM_SAMPLES * sizeof(int16_t) + (SPECTRUM_NUM_BINS + 1) * sizeof(float) + \
+                             SPECTRUM_MAX_PEAKS * sizeof(SPECTRUM_PEAK))
+#define BURST_STACK_MARGIN  128
+
+#ifndef BURST_RATE_HZ
+  #ifdef __AVR__
+    #define BURST_RATE_HZ     4000     // analogRead() takes ~112 us on the nano
+  #else
+    #define BURST_RATE_HZ     2000     // The SAMD core's analogRead() is slower, ~420 us at worst
+  #endif
+#endif
+
+typedef struct _BURST_STATS
+{
+  float RateHz;                 // Achieved rate, first to last sample
+  unsigned long DurationUs;
+  unsigned int LateSamples;     // Samples taken after their slot had already passed
+} BURST_STATS, *PTR_BURST_STATS;
 
 typedef enum _ADC_CTRL_B_RESSEL_NUM
 {
@@ -56,4 +78,8 @@ float resToTemp(float Res, bool print);
 
 float getSlope(unsigned char a, unsigned char b);
 
+void thermistorBurstCapture(int16_t * Samples, unsigned int Count, unsigned long RateHz, PTR_BURST_STATS Stats);
+
+void thermistorNoiseReport();
+
 #endif
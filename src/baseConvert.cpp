@@ -0,0 +1,308 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   baseConvert.cpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Definitions for the ADC code -> resistance -> temperature
+*   conversion and the sample filters
+*
+*/
+
+#include "baseConvert.hpp"
+
+// Resistance values that have been experimentally colelcted at specified temperatures.
+// True values have been scaled down by a factor of RES_SCALE_FACTOR.
+// Muliply values in this array by RES_SCALE_FACTOR to get the real resistance.
+
+// Slightly altered resistance values based on table in
+// Amazon listing: https://www.amazon.com/PQY-Temperature-Sensor-Sender-Electric/dp/B08MTJJTFK/ref=sr_1_5?crid=OERZDIYZEP9L&dib=eyJ2IjoiMSJ9.Ax70sMO3h5wLucVKUUK2Bwrb6nxw-Lu6bLvDJpekDGBI4DigFONbrwXPxV-sgw89X6lzM9883L_3LrC8yWnMoEvriPWv3NNzZ4iyQO-4LNvSLSnKYAsUfNtXQv3_lTDQFCRILeHsCVX_bl78Ms5qUjWPhXeWWkkRMH-TlVPSYIoXB5e7FeHGZ1fF0KqCmZFNPYI2JyvKXpjqIFwoegBKk649bYwI64wWf6Y5QYecLKk.b8o_X-dBp_B8-4zhSeJtW5AX77OmJs_QCWHkZqiLxsc&dib_tag=se&keywords=thermistor+1%2F8+npt&qid=1754964195&sprefix=thermistor+1%2F8+npt%2Caps%2C155&sr=8-5
+const uint16_t RESISTANCE_VALS[] PROGMEM =
+  {
+    3200,  //    | 68f
+    2150,  //    | 86f
+    1420,  //    | 104f 
+    895,   //    | 122f *
+    620,   //    | 140f *
+    428,   //    | 158f *
+    304,   //    | 176f *
+    224,   //    | 194f *
+    160,   //    | 212f *
+    124,   //    | 230f *
+    95,    //    | 248f *
+    73,    //    | 266f *
+    59,    //    | 284f *
+    45,    //    | 302f *
+    37,    //    | 320f *  
+    30    //     | 338f *
+  };
+
+// Farenheit temperatures based on datasheet in
+// Amazon listing for thermistor: 
+// https://www.amazon.com/PQY-Temperature-Sensor-Sender-Electric/dp/B08MTJJTFK/ref=sr_1_5?crid=OERZDIYZEP9L&dib=eyJ2IjoiMSJ9.Ax70sMO3h5wLucVKUUK2Bwrb6nxw-Lu6bLvDJpekDGBI4DigFONbrwXPxV-sgw89X6lzM9883L_3LrC8yWnMoEvriPWv3NNzZ4iyQO-4LNvSLSnKYAsUfNtXQv3_lTDQFCRILeHsCVX_bl78Ms5qUjWPhXeWWkkRMH-TlVPSYIoXB5e7FeHGZ1fF0KqCmZFNPYI2JyvKXpjqIFwoegBKk649bYwI64wWf6Y5QYecLKk.b8o_X-dBp_B8-4zhSeJtW5AX77OmJs_QCWHkZqiLxsc&dib_tag=se&keywords=thermistor+1%2F8+npt&qid=1754964195&sprefix=thermistor+1%2F8+npt%2Caps%2C155&sr=8-5
+const uint16_t TEMP_VALS[] PROGMEM =
+  {
+    68,
+    86,
+    104,
+    122,
+    140,
+    158,
+    176,
+    194,
+    212,
+    230,
+    248, 
+    266,
+    284,
+    302,
+    320,
+    338
+  };
+
+
+static float tableRes(unsigned char Ind)
+{
+  return float((unsigned long)pgm_read_word(&RESISTANCE_VALS[Ind]) * RES_SCALE_FACTOR);
+}
+
+static float tableTemp(unsigned char Ind)
+{
+  return float(pgm_read_word(&TEMP_VALS[Ind]));
+}
+
+
+/***********************************************************************************
+ * @brief - convertAdcToRes()
+ *  Converts one raw ADC code to thermistor resistance with convertCodeToRes().
+ *
+ * @param - Code: Raw ADC reading
+ * @param - AdcBits: ADC resolution the code was read at
+ *
+ * @return - float: Resistance in Ohms
+ ***********************************************************************************/
+float convertAdcToRes(uint16_t Code, unsigned char AdcBits)
+{
+  return convertCodeToRes(Code, float(1UL << AdcBits));
+}
+
+
+#ifdef __AVR__
+/***********************************************************************************
+ * @brief - convertResToTemp()
+ *  Converts one resistance to temperature using the lookup table. Finds the
+ *    segment Res falls in and interpolates along it, past both ends of the table
+ *    along the outer segments. On AVR every float operation is a library call, so
+ *    one search and one divide beat the hinge form's 14 multiply-adds, and no
+ *    table has to be built in RAM.
+ *
+ * @param - Res: Resistance in Ohms
+ *
+ * @return - float: Temperature in F
+ ***********************************************************************************/
+float convertResToTemp(float Res)
+{
+  unsigned char i = 0;
+
+  // RESISTANCE_VALS falls as the temperature rises
+  while (i < NUM_RES_VALUES - 2 && Res < tableRes(i + 1))
+  {
+    i++;
+  }
+
+  float res0 = tableRes(i);
+  float temp0 = tableTemp(i);
+  return temp0 + (Res - res0) * (tableTemp(i + 1) - temp0) / (tableRes(i + 1) - res0);
+}
+
+
+/***********************************************************************************
+ * @brief - convertResToTempBatch()
+ *  Converts a span of resistances to temperatures, one convertResToTemp() each.
+ *
+ * @param - Res: Resistances in Ohms
+ * @param - Temps: Output, Count temperatures in F
+ * @param - Count: Number of samples
+ *
+ * @return - None
+ ***********************************************************************************/
+void convertResToTempBatch(const float * Res, float * Temps, unsigned long Count)
+{
+  for (unsigned long n = 0; n < Count; n++)
+  {
+    Temps[n] = convertResToTemp(Res[n]);
+  }
+}
+
+#else
+
+// The lookup table is a continuous piecewise-linear curve, extrapolated past both ends
+// with the outer segments' slopes. It can be written without any segment search as
+//
+//   T(r) = T0 + s0 * (r - R0) + sum over interior points i of (s_i - s_(i-1)) * min(0, r - R_i)
+//
+// where s_i is the slope between points i and i+1. Every sample runs the same
+// instructions, so the batch loops vectorize on the host.
+#define NUM_HINGES          (NUM_RES_VALUES - 2)
+
+typedef struct _HINGE_TABLE
+{
+  bool Built;
+  float BaseTemp;                   // T0
+  float BaseRes;                    // R0
+  float BaseSlope;                  // s0
+  float Knot[NUM_HINGES];           // R_i, i = 1 .. NUM_RES_VALUES - 2
+  float SlopeDelta[NUM_HINGES];     // s_i - s_(i-1)
+} HINGE_TABLE, *PTR_HINGE_TABLE;
+
+HINGE_TABLE hingeTable = { false, 0, 0, 0, { 0 }, { 0 } };
+
+
+/***********************************************************************************
+ * @brief - segmentSlope()
+ *  Change in temp per change in resistance between two table points.
+ *
+ * @return - float: Slope in F per Ohm
+ ***********************************************************************************/
+static float segmentSlope(unsigned char Ind0, unsigned char Ind1)
+{
+  return (tableTemp(Ind1) - tableTemp(Ind0)) / (tableRes(Ind1) - tableRes(Ind0));
+}
+
+
+/***********************************************************************************
+ * @brief - buildHinges()
+ *  Derives the hinge form of the lookup table. Runs once.
+ *
+ * @return - None
+ ***********************************************************************************/
+static void buildHinges()
+{
+  float prevSlope = segmentSlope(0, 1);
+
+  hingeTable.BaseTemp = tableTemp(0);
+  hingeTable.BaseRes = tableRes(0);
+  hingeTable.BaseSlope = prevSlope;
+
+  for (unsigned char i = 0; i < NUM_HINGES; i++)
+  {
+    float slope = segmentSlope(i + 1, i + 2);
+
+    hingeTable.Knot[i] = tableRes(i + 1);
+    hingeTable.SlopeDelta[i] = slope - prevSlope;
+    prevSlope = slope;
+  }
+
+  hingeTable.Built = true;
+}
+
+
+/***********************************************************************************
+ * @brief - convertResToTemp()
+ *  Converts one resistance to temperature using the lookup table, in the hinge
+ *    form. Gives the same result as the AVR segment search up to float rounding.
+ *
+ * @param - Res: Resistance in Ohms
+ *
+ * @return - float: Temperature in F
+ ***********************************************************************************/
+float convertResToTemp(float Res)
+{
+  float temp;
+
+  if (!hingeTable.Built)
+  {
+    buildHinges();
+  }
+
+  temp = hingeTable.BaseTemp + hingeTable.BaseSlope * (Res - hingeTable.BaseRes);
+  for (unsigned char i = 0; i < NUM_HINGES; i++)
+  {
+    float d = Res - hingeTable.Knot[i];
+    temp += hingeTable.SlopeDelta[i] * ((d < 0.0f) ? d : 0.0f);
+  }
+
+  return temp;
+}
+
+
+/***********************************************************************************
+ * @brief - convertResToTempBatch()
+ *  Converts a span of resistances to temperatures. Hinges are the outer loop so
+ *    that the inner loop is a plain element-wise pass over the samples.
+ *
+ * @param - Res: Resistances in Ohms
+ * @param - Temps: Output, Count temperatures in F. May not alias Res.
+ * @param - Count: Number of samples
+ *
+ * @return - None
+ ***********************************************************************************/
+void convertResToTempBatch(const float * Res, float * Temps, unsigned long Count)
+{
+  if (!hingeTable.Built)
+  {
+    buildHinges();
+  }
+
+  const float baseTemp = hingeTable.BaseTemp;
+  const float baseRes = hingeTable.BaseRes;
+  const float baseSlope = hingeTable.BaseSlope;
+
+  for (unsigned long n = 0; n < Count; n++)
+  {
+    Temps[n] = baseTemp + baseSlope * (Res[n] - baseRes);
+  }
+
+  for (unsigned char i = 0; i < NUM_HINGES; i++)
+  {
+    const float knot = hingeTable.Knot[i];
+    const float delta = hingeTable.SlopeDelta[i];
+
+    for (unsigned long n = 0; n < Count; n++)
+    {
+      float d = Res[n] - knot;
+      Temps[n] += delta * ((d < 0.0f) ? d : 0.0f);
+    }
+  }
+}
+#endif
+
+
+/***********************************************************************************
+ * @brief - convertAdcToResBatch()
+ *  Converts a span of raw ADC codes to resistances.
+ *
+ * @param - Codes: Raw ADC readings
+ * @param - Res: Output, Count resistances in Ohms
+ * @param - Count: Number of samples
+ * @param - AdcBits: ADC resolution the codes were read at
+ *
+ * @return - None
+ ***********************************************************************************/
+void convertAdcToResBatch(const uint16_t * Codes, float * Res, unsigned long Count, unsigned char AdcBits)
+{
+  const float fullScale = float(1UL << AdcBits);
+
+  for (unsigned long n = 0; n < Count; n++)
+  {
+    Res[n] = convertCodeToRes(Codes[n], fullScale);
+  }
+}
+
+
+/***********************************************************************************
+ * @brief - convertAdcToTempBatch()
+ *  Converts a span of raw ADC codes to resistance and temperature in one call.
+ *
+ * @param - Codes: Raw ADC readings
+ * @param - Res: Output, Count resistances in Ohms
+ * @param - Temps: Output, Count temperatures in F
+ * @param - Count: Number of samples
+ * @param - AdcBits: ADC resolution the codes were read at
+ *
+ * @return - None
+ ***********************************************************************************/
+void convertAdcToTempBatch(const uint16_t * Codes, float * Res, float * Temps, unsigned long Count, unsigned char AdcBits)
+{
+  convertAdcToResBatch(Codes, Res, Count, AdcBits);
+  convertResToTempBatch(Res, Temps, Count);
+}
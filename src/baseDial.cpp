@@ -0,0 +1,218 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   baseDial.cpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Definitions for the dial gauge geometry
+*
+*/
+
+#include "baseDial.hpp"
+
+#define QUARTER_TURN        DIAL_DEG(90)
+#define FULL_TURN           DIAL_DEG(360)
+
+// sin() in Q14 for 0..90 degrees in 1 degree steps. Values in between are interpolated.
+const int16_t DIAL_SIN_TABLE[91] PROGMEM = {
+  0, 286, 572, 857, 1143, 1428, 1713, 1997, 2280, 2563,
+  2845, 3126, 3406, 3686, 3964, 4240, 4516, 4790, 5063, 5334,
+  5604, 5872, 6138, 6402, 6664, 6924, 7182, 7438, 7692, 7943,
+  8192, 8438, 8682, 8923, 9162, 9397, 9630, 9860, 10087, 10311,
+  10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+  12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+  14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+  15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+  16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+  16384
+};
+
+
+// sin() for 0..QUARTER_TURN
+static int16_t quarterSin(int16_t Angle)
+{
+  unsigned char deg = Angle / DIAL_ANGLE_SCALE;
+  unsigned char frac = Angle % DIAL_ANGLE_SCALE;
+  int16_t v0 = (int16_t)pgm_read_word(&DIAL_SIN_TABLE[deg]);
+
+  if (frac == 0)
+  {
+    return v0;
+  }
+
+  int16_t v1 = (int16_t)pgm_read_word(&DIAL_SIN_TABLE[deg + 1]);
+  return v0 + (int16_t)(((int32_t)(v1 - v0) * frac) / DIAL_ANGLE_SCALE);
+}
+
+
+/***********************************************************************************
+ * @brief - dialSin()
+ *  Fixed-point sine, folded onto the first quadrant of the table.
+ *
+ * @param - Angle: Any angle in 1/DIAL_ANGLE_SCALE degree
+ *
+ * @return - int16_t: sin(Angle) in Q14
+ ***********************************************************************************/
+int16_t dialSin(int16_t Angle)
+{
+  int16_t a = Angle % FULL_TURN;
+
+  if (a < 0)
+  {
+    a += FULL_TURN;
+  }
+
+  switch (a / QUARTER_TURN)
+  {
+    case 0:  return quarterSin(a);
+    case 1:  return quarterSin(2 * QUARTER_TURN - a);
+    case 2:  return -quarterSin(a - 2 * QUARTER_TURN);
+    default: return -quarterSin(FULL_TURN - a);
+  }
+}
+
+
+int16_t dialCos(int16_t Angle)
+{
+  return dialSin(Angle + QUARTER_TURN);
+}
+
+
+/***********************************************************************************
+ * @brief - dialPoint()
+ *  Screen position at Radius pixels from the center along Angle, rounded to the
+ *    nearest pixel. Screen y grows downwards, so the sine is subtracted.
+ *
+ * @return - None
+ ***********************************************************************************/
+void dialPoint(int16_t Cx, int16_t Cy, int16_t Radius, int16_t Angle, int16_t * X, int16_t * Y)
+{
+  const int32_t half = 1L << (DIAL_TRIG_SHIFT - 1);
+
+  *X = Cx + (int16_t)(((int32_t)Radius * dialCos(Angle) + half) >> DIAL_TRIG_SHIFT);
+  *Y = Cy - (int16_t)(((int32_t)Radius * dialSin(Angle) + half) >> DIAL_TRIG_SHIFT);
+}
+
+
+/***********************************************************************************
+ * @brief - dialRasterLine()
+ *  Bresenham line from (X0, Y0) to (X1, Y1), both ends included. The same two
+ *    points always give the same pixels, which is what lets the needle be erased
+ *    by rasterizing it again.
+ *
+ * @param - Plot: Called once per pixel, nothing is clipped
+ * @param - Ctx: Passed through to Plot
+ *
+ * @return - None
+ ***********************************************************************************/
+void dialRasterLine(int16_t X0, int16_t Y0, int16_t X1, int16_t Y1, DIAL_PLOT_FN Plot, void * Ctx)
+{
+  int16_t dx = X1 > X0 ? X1 - X0 : X0 - X1;
+  int16_t dy = Y1 > Y0 ? Y0 - Y1 : Y1 - Y0;     // Negative
+  int16_t sx = X0 < X1 ? 1 : -1;
+  int16_t sy = Y0 < Y1 ? 1 : -1;
+  int16_t err = dx + dy;
+
+  for (;;)
+  {
+    Plot(X0, Y0, Ctx);
+    if (X0 == X1 && Y0 == Y1)
+    {
+      break;
+    }
+
+    int16_t e2 = 2 * err;
+    if (e2 >= dy)
+    {
+      err += dy;
+      X0 += sx;
+    }
+    if (e2 <= dx)
+    {
+      err += dx;
+      Y0 += sy;
+    }
+  }
+}
+
+
+/***********************************************************************************
+ * @brief - dialValueToAngle()
+ *  Maps a reading onto the scale. Readings outside Min..Max are pinned to the ends
+ *    of the scale.
+ *
+ * @param - StartAngle: Angle of Min
+ * @param - SweepAngle: Angle from Min to Max, negative sweeps clockwise
+ *
+ * @return - int16_t: Needle angle
+ ***********************************************************************************/
+int16_t dialValueToAngle(int Value, int Min, int Max, int16_t StartAngle, int16_t SweepAngle)
+{
+  if (Max <= Min || Value <= Min)
+  {
+    return StartAngle;
+  }
+  if (Value >= Max)
+  {
+    return StartAngle + SweepAngle;
+  }
+
+  return StartAngle + (int16_t)((int32_t)SweepAngle * (Value - Min) / (Max - Min));
+}
+
+
+void dialNeedleInit(PTR_DIAL_NEEDLE Needle, int16_t Angle, unsigned long NowMs)
+{
+  Needle->Angle = Angle;
+  Needle->Target = Angle;
+  Needle->LastMs = NowMs;
+}
+
+
+void dialNeedleSetTarget(PTR_DIAL_NEEDLE Needle, int16_t Target)
+{
+  Needle->Target = Target;
+}
+
+
+/***********************************************************************************
+ * @brief - dialNeedleStep()
+ *  Moves the needle towards its target by the share of the remaining distance
+ *    that matches the time since the last step, so it slows down as it arrives.
+ *    The step is at least one angle unit, so it always settles on the target.
+ *    Readings only change in whole degrees F, this fills in the motion between
+ *    them at whatever rate frames are drawn.
+ *
+ * @return - bool: True if the angle changed
+ ***********************************************************************************/
+bool dialNeedleStep(PTR_DIAL_NEEDLE Needle, unsigned long NowMs)
+{
+  unsigned long elapsedMs = NowMs - Needle->LastMs;
+  int16_t diff = Needle->Target - Needle->Angle;
+  int16_t step;
+
+  if (diff == 0)
+  {
+    Needle->LastMs = NowMs;
+    return false;
+  }
+  if (elapsedMs == 0)
+  {
+    return false;
+  }
+
+  Needle->LastMs = NowMs;
+  if (elapsedMs >= DIAL_EASE_MS)
+  {
+    Needle->Angle = Needle->Target;
+    return true;
+  }
+
+  step = (int16_t)((int32_t)diff * (int32_t)elapsedMs / DIAL_EASE_MS);
+  if (step == 0)
+  {
+    step = diff > 0 ? 1 : -1;
+  }
+
+  Needle->Angle += step;
+  return true;
+}
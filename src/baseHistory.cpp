@@ -0,0 +1,415 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   baseHistory.cpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Definitions for the tiered temperature history store
+*
+*/
+
+#include "baseHistory.hpp"
+
+#define MS_PER_SEC      1000UL
+
+// Running aggregate of a bucket that has not been closed yet
+typedef struct _HIST_ACCUM
+{
+  int16_t Min;
+  int16_t Max;
+  long Sum;                         // Sum of the raw samples, so parents weight by sample count
+  unsigned long Count;              // Number of raw samples in Sum
+  unsigned char Children;           // Child buckets folded in so far
+} HIST_ACCUM, *PTR_HIST_ACCUM;
+
+typedef struct _HIST_TIER
+{
+  PTR_HIST_BUCKET Buckets;          // Ring of closed buckets
+  unsigned char Len;                // Number of buckets in the ring
+  unsigned char Head;               // Index the next closed bucket is written to
+  unsigned char Filled;             // Number of valid buckets in the ring
+  unsigned char Ratio;              // Child buckets folded into one bucket of this tier
+  unsigned int SecPerBucket;
+  unsigned long Closed;             // Buckets closed since historyInit()
+  HIST_ACCUM Pending;
+} HIST_TIER, *PTR_HIST_TIER;
+
+HIST_BUCKET tier0Buckets[HIST_TIER0_LEN];
+HIST_BUCKET tier1Buckets[HIST_TIER1_LEN];
+HIST_BUCKET tier2Buckets[HIST_TIER2_LEN];
+
+HIST_TIER histTiers[HIST_TIER_MAX] =
+  {
+    { tier0Buckets, HIST_TIER0_LEN, 0, 0, 0, HIST_TIER0_SEC_PER_BUCKET, 0, { 0, 0, 0, 0, 0 } },
+    { tier1Buckets, HIST_TIER1_LEN, 0, 0,
+        HIST_TIER1_SEC_PER_BUCKET / HIST_TIER0_SEC_PER_BUCKET, HIST_TIER1_SEC_PER_BUCKET, 0, { 0, 0, 0, 0, 0 } },
+    { tier2Buckets, HIST_TIER2_LEN, 0, 0,
+        HIST_TIER2_SEC_PER_BUCKET / HIST_TIER1_SEC_PER_BUCKET, HIST_TIER2_SEC_PER_BUCKET, 0, { 0, 0, 0, 0, 0 } }
+  };
+
+unsigned long histSecondStartMs = 0;        // millis() at which the current per-second bucket opened
+bool histStarted = false;
+
+
+/***********************************************************************************
+ * @brief - accumFold()
+ *  Folds a range and a sum of Count samples into a pending accumulator.
+ *
+ * @return - None
+ ***********************************************************************************/
+static void accumFold(PTR_HIST_ACCUM Accum, int16_t Min, int16_t Max, long Sum, unsigned long Count)
+{
+  if (Accum->Count == 0)
+  {
+    Accum->Min = Min;
+    Accum->Max = Max;
+  }
+  else
+  {
+    if (Min < Accum->Min) Accum->Min = Min;
+    if (Max > Accum->Max) Accum->Max = Max;
+  }
+
+  Accum->Sum += Sum;
+  Accum->Count += Count;
+}
+
+
+// Sum / Count rounded to nearest, truncation would bias every bucket half a degree low
+static int16_t roundedMean(long Sum, unsigned long Count)
+{
+  long half = (long)(Count / 2);
+
+  return (int16_t)((Sum >= 0 ? Sum + half : Sum - half) / (long)Count);
+}
+
+
+// Writes a closed bucket into the tier's ring
+static void tierPush(PTR_HIST_TIER Tier, HIST_BUCKET Bucket)
+{
+  Tier->Buckets[Tier->Head] = Bucket;
+  Tier->Head = (Tier->Head + 1) % Tier->Len;
+  if (Tier->Filled < Tier->Len)
+  {
+    Tier->Filled++;
+  }
+}
+
+
+/***********************************************************************************
+ * @brief - tierStore()
+ *  Closes the pending bucket of a tier, stores it in the tier's ring, and folds it
+ *    into the next tier up. The parent gets the bucket's sample sum and count
+ *    rather than its mean, so a bucket with few samples does not weigh as much as
+ *    a full one. Leaves closing the parent to the caller.
+ *
+ * @param - Tier: Index of the tier to close
+ *
+ * @return - true: The parent has now collected Ratio buckets and is due to close
+ ***********************************************************************************/
+static bool tierStore(unsigned char Tier)
+{
+  PTR_HIST_TIER tier = &histTiers[Tier];
+  HIST_BUCKET bucket;
+  bool parentDue = false;
+
+  if (tier->Pending.Count == 0)
+  {
+    return false;
+  }
+
+  bucket.Min = tier->Pending.Min;
+  bucket.Max = tier->Pending.Max;
+  bucket.Mean = roundedMean(tier->Pending.Sum, tier->Pending.Count);
+
+  tierPush(tier, bucket);
+  tier->Closed++;
+
+  if (Tier + 1 < HIST_TIER_MAX)
+  {
+    PTR_HIST_TIER parent = &histTiers[Tier + 1];
+    accumFold(&parent->Pending, bucket.Min, bucket.Max, tier->Pending.Sum, tier->Pending.Count);
+    parent->Pending.Children++;
+    parentDue = (parent->Pending.Children >= parent->Ratio);
+  }
+
+  tier->Pending.Sum = 0;
+  tier->Pending.Count = 0;
+  tier->Pending.Children = 0;
+
+  return parentDue;
+}
+
+
+/***********************************************************************************
+ * @brief - tierClose()
+ *  Closes the pending bucket of a tier, and the next tier up once it has collected
+ *    Ratio buckets. Depth is bounded by HIST_TIER_MAX, so this is O(1).
+ *
+ * @param - Tier: Index of the tier to close
+ *
+ * @return - None
+ ***********************************************************************************/
+static void tierClose(unsigned char Tier)
+{
+  if (tierStore(Tier))
+  {
+    tierClose(Tier + 1);
+  }
+}
+
+
+/***********************************************************************************
+ * @brief - tierFill()
+ *  Feeds Children child buckets that all hold one value into a tier, for a gap in
+ *    the samples. The first close may still hold real samples and goes through
+ *    tierStore(). Every later close is a bucket of the held value, and only the
+ *    last Len of them are written, so a tier costs at most Len + 1 writes however
+ *    long the gap. The parent is then fed the pure buckets the same way.
+ *
+ * @param - Tier: Index of the tier to fill
+ * @param - Held: Value of every child bucket
+ * @param - Children: Number of child buckets, seconds for the per-second tier
+ *
+ * @return - None
+ ***********************************************************************************/
+static void tierFill(unsigned char Tier, int16_t Held, unsigned long Children)
+{
+  PTR_HIST_TIER tier = &histTiers[Tier];
+  unsigned char ratio = (Tier == HIST_TIER_SECONDS) ? 1 : tier->Ratio;
+  unsigned long perChild = (Tier == HIST_TIER_SECONDS) ? 1 : histTiers[Tier - 1].SecPerBucket;
+  unsigned long need = ratio - tier->Pending.Children;
+  unsigned long closes;
+  unsigned long rest;
+  HIST_BUCKET held = { Held, Held, Held };
+
+  if (Children < need)
+  {
+    if (Children > 0)
+    {
+      accumFold(&tier->Pending, Held, Held, (long)Held * (long)(Children * perChild), Children * perChild);
+      tier->Pending.Children += Children;
+    }
+    return;
+  }
+
+  // Top up and close the pending bucket, then the rest are whole buckets of Held
+  if (need > 0)
+  {
+    accumFold(&tier->Pending, Held, Held, (long)Held * (long)(need * perChild), need * perChild);
+  }
+  tierStore(Tier);
+
+  closes = (Children - need) / ratio;
+  rest = (Children - need) % ratio;
+
+  for (unsigned long i = (closes > tier->Len) ? closes - tier->Len : 0; i < closes; i++)
+  {
+    tierPush(tier, held);
+  }
+  tier->Closed += closes;
+
+  if (rest > 0)
+  {
+    accumFold(&tier->Pending, Held, Held, (long)Held * (long)(rest * perChild), rest * perChild);
+    tier->Pending.Children = rest;
+  }
+
+  if (Tier + 1 < HIST_TIER_MAX)
+  {
+    tierFill(Tier + 1, Held, closes);
+  }
+}
+
+
+/***************************************************************************************
+ * Empties every tier. History restarts with the next call to historyAddSample().
+ ***************************************************************************************/
+void historyInit()
+{
+  for (unsigned char i = 0; i < HIST_TIER_MAX; i++)
+  {
+    histTiers[i].Head = 0;
+    histTiers[i].Filled = 0;
+    histTiers[i].Closed = 0;
+    histTiers[i].Pending.Sum = 0;
+    histTiers[i].Pending.Count = 0;
+    histTiers[i].Pending.Children = 0;
+  }
+
+  histStarted = false;
+}
+
+
+/***********************************************************************************
+ * @brief - historyAddSample()
+ *  Adds a temperature sample to the current per-second bucket. Closes the bucket
+ *    (and cascades into the coarser tiers) once a second has elapsed. O(1).
+ *
+ *  If samples stop for more than a second, every second of the gap is back-filled
+ *    with one sample of the last bucket's mean, so each bucket still covers its
+ *    own span of time and "the last N seconds" means N seconds. A blocking call
+ *    (a capture stream, a long animation) is the usual cause. The fill writes at
+ *    most Len + 1 buckets per tier however long the gap, see tierFill().
+ *
+ * @param - Temp: Temperature sample
+ * @param - NowMs: Current time in ms, normally millis()
+ *
+ * @return - None
+ ***********************************************************************************/
+void historyAddSample(int Temp, unsigned long NowMs)
+{
+  unsigned long elapsed;
+
+  if (!histStarted)
+  {
+    histSecondStartMs = NowMs;
+    histStarted = true;
+  }
+
+  elapsed = NowMs - histSecondStartMs;
+  if (elapsed >= MS_PER_SEC)
+  {
+    PTR_HIST_TIER seconds = &histTiers[HIST_TIER_SECONDS];
+    unsigned long missed = elapsed / MS_PER_SEC - 1;
+
+    tierClose(HIST_TIER_SECONDS);
+    histSecondStartMs += (elapsed / MS_PER_SEC) * MS_PER_SEC;
+
+    if (missed > 0 && seconds->Filled > 0)
+    {
+      tierFill(HIST_TIER_SECONDS, seconds->Buckets[(seconds->Head + seconds->Len - 1) % seconds->Len].Mean, missed);
+    }
+  }
+
+  accumFold(&histTiers[HIST_TIER_SECONDS].Pending, Temp, Temp, Temp, 1);
+}
+
+
+/***********************************************************************************
+ * @brief - historyGetStats()
+ *  Gets min, max and mean over (roughly) the last Seconds seconds. Uses the finest
+ *    tier whose span covers the request, so at most one ring is scanned.
+ *    Only closed buckets are considered, so results lag by at most one bucket.
+ *    Every bucket of a tier spans the same time, so the mean is a time average.
+ *
+ * @param - Seconds: Length of the window to summarize
+ * @param - Stats: Filled in with the result on success
+ *
+ * @return - HIST_STATUS_SUCCESS: Stats is valid
+ * @return - HIST_STATUS_NO_DATA: No bucket has been closed yet
+ * @return - HIST_STATUS_INVALID_PARAM: Seconds is zero or Stats is NULL
+ ***********************************************************************************/
+HIST_STATUS historyGetStats(unsigned long Seconds, PTR_HIST_STATS Stats)
+{
+  PTR_HIST_TIER tier;
+  unsigned char tierNum = 0;
+  unsigned long numBuckets;
+  long sum = 0;
+
+  if (Seconds == 0 || Stats == 0)
+  {
+    return HIST_STATUS_INVALID_PARAM;
+  }
+
+  // Pick the finest tier that covers the window. Fall back to the coarsest one.
+  while (tierNum < HIST_TIER_MAX - 1 &&
+         Seconds > (unsigned long)histTiers[tierNum].Len * histTiers[tierNum].SecPerBucket)
+  {
+    tierNum++;
+  }
+
+  tier = &histTiers[tierNum];
+  numBuckets = (Seconds + tier->SecPerBucket - 1) / tier->SecPerBucket;
+  if (numBuckets > tier->Filled)
+  {
+    numBuckets = tier->Filled;
+  }
+
+  if (numBuckets == 0)
+  {
+    return HIST_STATUS_NO_DATA;
+  }
+
+  for (unsigned char age = 0; age < numBuckets; age++)
+  {
+    PTR_HIST_BUCKET bucket = &tier->Buckets[(tier->Head + tier->Len - 1 - age) % tier->Len];
+
+    if (age == 0 || bucket->Min < Stats->Min) Stats->Min = bucket->Min;
+    if (age == 0 || bucket->Max > Stats->Max) Stats->Max = bucket->Max;
+    sum += bucket->Mean;
+  }
+
+  Stats->Mean = roundedMean(sum, numBuckets);
+  Stats->Seconds = numBuckets * tier->SecPerBucket;
+
+  return HIST_STATUS_SUCCESS;
+}
+
+
+/***********************************************************************************
+ * @brief - historyGetBucket()
+ *  Gets a closed bucket from one tier. Age 0 is the most recently closed bucket.
+ *    Intended for trend views that walk a tier from newest to oldest.
+ *
+ * @param - Tier: Tier to read from
+ * @param - Age: Number of buckets back from the newest one
+ * @param - Bucket: Filled in with the bucket on success
+ *
+ * @return - HIST_STATUS_SUCCESS: Bucket is valid
+ * @return - HIST_STATUS_NO_DATA: The tier does not hold that many buckets yet
+ * @return - HIST_STATUS_INVALID_PARAM: Tier is out of range or Bucket is NULL
+ ***********************************************************************************/
+HIST_STATUS historyGetBucket(HIST_TIER_NUM Tier, unsigned char Age, PTR_HIST_BUCKET Bucket)
+{
+  PTR_HIST_TIER tier;
+
+  if (Tier >= HIST_TIER_MAX || Bucket == 0)
+  {
+    return HIST_STATUS_INVALID_PARAM;
+  }
+
+  tier = &histTiers[Tier];
+  if (Age >= tier->Filled)
+  {
+    return HIST_STATUS_NO_DATA;
+  }
+
+  *Bucket = tier->Buckets[(tier->Head + tier->Len - 1 - Age) % tier->Len];
+  return HIST_STATUS_SUCCESS;
+}
+
+
+/***********************************************************************************
+ * @brief - historyGetNumBuckets()
+ *  Gets the number of closed buckets currently held by a tier.
+ *
+ * @return - unsigned char: Number of valid buckets, 0 if Tier is out of range
+ ***********************************************************************************/
+unsigned char historyGetNumBuckets(HIST_TIER_NUM Tier)
+{
+  if (Tier >= HIST_TIER_MAX)
+  {
+    return 0;
+  }
+
+  return histTiers[Tier].Filled;
+}
+
+
+/***********************************************************************************
+ * @brief - historyGetNumClosed()
+ *  Gets the number of buckets a tier has closed since historyInit(). Readers that
+ *    follow a tier, like the trend fit, compare it against the last value they
+ *    saw to find the buckets that are new to them.
+ *
+ * @return - unsigned long: Buckets closed so far, 0 if Tier is out of range
+ ***********************************************************************************/
+unsigned long historyGetNumClosed(HIST_TIER_NUM Tier)
+{
+  if (Tier >= HIST_TIER_MAX)
+  {
+    return 0;
+  }
+
+  return histTiers[Tier].Closed;
+}
@@ -0,0 +1,171 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   baseSpectrum.cpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Definitions for finding the dominant noise frequencies in a burst
+*   of raw ADC samples
+*
+*/
+
+#include <math.h>
+#include "baseSpectrum.hpp"
+
+#define HALF_SEG            (SPECTRUM_SEG_LEN / 2)
+
+int16_t spectrumWindow[HALF_SEG + 1];   // First half of a Hann window, it is symmetric
+
+
+/***************************************************************************************
+ * Builds the window table. Call once before spectrumAnalyze().
+ ***************************************************************************************/
+void spectrumInit()
+{
+  for (unsigned int n = 0; n <= HALF_SEG; n++)
+  {
+    float w = 0.5f - 0.5f * cosf(2.0f * float(M_PI) * n / SPECTRUM_SEG_LEN);
+    spectrumWindow[n] = (int16_t)(w * ((1L << SPECTRUM_WINDOW_SHIFT) - 1) + 0.5f);
+  }
+}
+
+
+/***********************************************************************************
+ * @brief - goertzelPower()
+ *  Runs one Goertzel filter over one segment, windowing the samples as they go in
+ *    so no copy of the segment is needed.
+ *
+ *    s[n] = x[n] + coeff * s[n-1] - s[n-2]
+ *    power = s1^2 + s2^2 - coeff * s1 * s2
+ *
+ *  The state reaches ~2^19 for full-scale 12-bit input, so the Q14 product needs
+ *    64 bits. Everything else is 32-bit integer.
+ *
+ * @param - Segment: SPECTRUM_SEG_LEN raw samples
+ * @param - Mean: DC level to remove
+ * @param - Coeff: 2 * cos(2 * pi * k / SPECTRUM_SEG_LEN) in Q14
+ *
+ * @return - float: Power of bin k
+ ***********************************************************************************/
+static float goertzelPower(const int16_t * Segment, int16_t Mean, int32_t Coeff)
+{
+  int32_t s1 = 0, s2 = 0;
+
+  for (unsigned int n = 0; n < SPECTRUM_SEG_LEN; n++)
+  {
+    int16_t w = spectrumWindow[n <= HALF_SEG ? n : SPECTRUM_SEG_LEN - n];
+    int32_t x = ((int32_t)(Segment[n] - Mean) * w) >> SPECTRUM_WINDOW_SHIFT;
+    int32_t s = x + (int32_t)(((int64_t)Coeff * s1) >> SPECTRUM_COEFF_SHIFT) - s2;
+
+    s2 = s1;
+    s1 = s;
+  }
+
+  float f1 = s1, f2 = s2;
+  return f1 * f1 + f2 * f2 - (float(Coeff) / (1L << SPECTRUM_COEFF_SHIFT)) * f1 * f2;
+}
+
+
+/***********************************************************************************
+ * @brief - spectrumAnalyze()
+ *  Removes the burst's mean, then averages the Goertzel power of every bin over
+ *    all whole segments in the burst. Samples past the last whole segment are
+ *    ignored.
+ *
+ * @param - Samples: Raw ADC codes, sampled at a fixed rate
+ * @param - Count: Number of samples, at least SPECTRUM_SEG_LEN
+ * @param - Amplitude: SPECTRUM_NUM_BINS + 1 entries. Receives the sine amplitude in
+ *                     ADC codes for bins 0..SPECTRUM_NUM_BINS. Bin 0 (DC) is 0.
+ *
+ * @return - SPECTRUM_STATUS: SPECTRUM_STATUS_SUCCESS if Amplitude was filled
+ ***********************************************************************************/
+SPECTRUM_STATUS spectrumAnalyze(const int16_t * Samples, unsigned int Count, float * Amplitude)
+{
+  unsigned int numSegs = Count / SPECTRUM_SEG_LEN;
+  long sum = 0;
+  int16_t mean;
+
+  if (Samples == 0 || Amplitude == 0 || numSegs == 0)
+  {
+    return SPECTRUM_STATUS_INVALID_PARAM;
+  }
+
+  for (unsigned int i = 0; i < numSegs * SPECTRUM_SEG_LEN; i++)
+  {
+    sum += Samples[i];
+  }
+  mean = sum / long(numSegs * SPECTRUM_SEG_LEN);
+
+  Amplitude[0] = 0;
+  for (unsigned int k = 1; k <= SPECTRUM_NUM_BINS; k++)
+  {
+    int32_t coeff = (int32_t)lroundf(2.0f * cosf(2.0f * float(M_PI) * k / SPECTRUM_SEG_LEN) * (1L << SPECTRUM_COEFF_SHIFT));
+    float power = 0;
+
+    for (unsigned int seg = 0; seg < numSegs; seg++)
+    {
+      power += goertzelPower(&Samples[seg * SPECTRUM_SEG_LEN], mean, coeff);
+    }
+
+    // A sine of amplitude A gives |X| = A * N / 4 through a Hann window
+    Amplitude[k] = 4.0f * sqrtf(power / numSegs) / SPECTRUM_SEG_LEN;
+  }
+
+  return SPECTRUM_STATUS_SUCCESS;
+}
+
+
+/***********************************************************************************
+ * @brief - spectrumFindPeaks()
+ *  Picks the strongest local maxima. Each peak's frequency is refined by fitting
+ *    a parabola through the bin and its neighbours.
+ *
+ * @param - Amplitude: Output of spectrumAnalyze()
+ * @param - RateHz: Rate the burst was sampled at
+ * @param - Peaks: Receives up to MaxPeaks peaks, strongest first
+ * @param - MaxPeaks: Size of Peaks
+ *
+ * @return - unsigned char: Number of peaks found
+ ***********************************************************************************/
+unsigned char spectrumFindPeaks(const float * Amplitude, float RateHz, PTR_SPECTRUM_PEAK Peaks, unsigned char MaxPeaks)
+{
+  unsigned char found = 0;
+  float binHz = RateHz / SPECTRUM_SEG_LEN;
+
+  for (unsigned int k = 1; k <= SPECTRUM_NUM_BINS; k++)
+  {
+    float left = Amplitude[k - 1];
+    float right = (k < SPECTRUM_NUM_BINS) ? Amplitude[k + 1] : 0;
+    float a = Amplitude[k];
+
+    if (a <= left || a < right || a <= 0)
+    {
+      continue;
+    }
+
+    float denom = left - 2 * a + right;
+    float offset = (denom != 0 && k > 1 && k < SPECTRUM_NUM_BINS) ? 0.5f * (left - right) / denom : 0;
+
+    // Insert in order of amplitude, dropping the weakest when full
+    unsigned char pos = found;
+    while (pos > 0 && Peaks[pos - 1].Amplitude < a)
+    {
+      if (pos < MaxPeaks)
+      {
+        Peaks[pos] = Peaks[pos - 1];
+      }
+      pos--;
+    }
+
+    if (pos < MaxPeaks)
+    {
+      Peaks[pos].FreqHz = (k + offset) * binHz;
+      Peaks[pos].Amplitude = a;
+      if (found < MaxPeaks)
+      {
+        found++;
+      }
+    }
+  }
+
+  return found;
+}
@@ -0,0 +1,165 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   baseTempHist.cpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Definitions for the time-at-temperature histogram
+*
+*/
+
+#include "baseTempHist.hpp"
+
+#define MS_PER_SEC      1000
+
+TEMPHIST_RECORD tempHist;
+uint32_t tempHistTotal = 0;             // Sum of tempHist.Seconds
+uint16_t tempHistResidualMs = 0;        // Time not yet counted as a whole second
+unsigned char tempHistLastBucket = 0;
+unsigned long tempHistLastMs = 0;
+bool tempHistHaveSample = false;
+
+
+static unsigned char tempToBucket(int Temp)
+{
+  if (Temp < TEMPHIST_MIN_F)
+  {
+    return 0;
+  }
+
+  int bucket = 1 + (Temp - TEMPHIST_MIN_F) / TEMPHIST_WIDTH_F;
+  return bucket >= TEMPHIST_NUM_BUCKETS ? TEMPHIST_NUM_BUCKETS - 1 : bucket;
+}
+
+
+static uint32_t recordCheck(const TEMPHIST_RECORD * Record)
+{
+  uint32_t check = ((uint32_t)Record->Magic << 16) ^ ((uint32_t)Record->Version << 8) ^ Record->NumBuckets;
+
+  for (unsigned char i = 0; i < TEMPHIST_NUM_BUCKETS; i++)
+  {
+    check = (check << 5 | check >> 27) ^ Record->Seconds[i];
+  }
+  return check;
+}
+
+
+/***************************************************************************************
+ * Zeroes all bucket counts.
+ ***************************************************************************************/
+void tempHistInit()
+{
+  tempHist.Magic = TEMPHIST_MAGIC;
+  tempHist.Version = TEMPHIST_VERSION;
+  tempHist.NumBuckets = TEMPHIST_NUM_BUCKETS;
+  tempHist.MinF = TEMPHIST_MIN_F;
+  tempHist.WidthF = TEMPHIST_WIDTH_F;
+  for (unsigned char i = 0; i < TEMPHIST_NUM_BUCKETS; i++)
+  {
+    tempHist.Seconds[i] = 0;
+  }
+  tempHist.Check = 0;
+
+  tempHistTotal = 0;
+  tempHistResidualMs = 0;
+  tempHistHaveSample = false;
+}
+
+
+/***********************************************************************************
+ * @brief - tempHistAddSample()
+ *  Counts the time since the previous sample towards the previous sample's band.
+ *    O(1). Fractions of a second are carried over to the next sample.
+ *
+ * @param - Temp: Filtered temperature sample
+ * @param - NowMs: Current time in ms, normally millis()
+ *
+ * @return - None
+ ***********************************************************************************/
+void tempHistAddSample(int Temp, unsigned long NowMs)
+{
+  if (tempHistHaveSample)
+  {
+    unsigned long elapsedMs = NowMs - tempHistLastMs;
+
+    if (elapsedMs <= TEMPHIST_MAX_GAP_MS)
+    {
+      elapsedMs += tempHistResidualMs;
+      tempHist.Seconds[tempHistLastBucket] += elapsedMs / MS_PER_SEC;
+      tempHistTotal += elapsedMs / MS_PER_SEC;
+      tempHistResidualMs = elapsedMs % MS_PER_SEC;
+    }
+  }
+
+  tempHistLastBucket = tempToBucket(Temp);
+  tempHistLastMs = NowMs;
+  tempHistHaveSample = true;
+}
+
+
+uint32_t tempHistGetSeconds(unsigned char Bucket)
+{
+  return Bucket < TEMPHIST_NUM_BUCKETS ? tempHist.Seconds[Bucket] : 0;
+}
+
+
+// Bucket 0 has no lower edge, this is where bucket 1 starts minus one width
+int tempHistGetBucketLowF(unsigned char Bucket)
+{
+  return TEMPHIST_MIN_F + (int(Bucket) - 1) * TEMPHIST_WIDTH_F;
+}
+
+
+uint32_t tempHistGetTotalSeconds()
+{
+  return tempHistTotal;
+}
+
+
+/***********************************************************************************
+ * @brief - tempHistSeal()
+ *  Updates the record's check value so it can be saved or sent.
+ *
+ * @return - const TEMPHIST_RECORD *: The live record
+ ***********************************************************************************/
+const TEMPHIST_RECORD * tempHistSeal()
+{
+  tempHist.Check = recordCheck(&tempHist);
+  return &tempHist;
+}
+
+
+/***********************************************************************************
+ * @brief - tempHistRestore()
+ *  Loads counts from a saved record. Blank or foreign storage is rejected and the
+ *    current counts are kept.
+ *
+ * @param - Record: Record read back from storage
+ *
+ * @return - TEMPHIST_STATUS: TEMPHIST_STATUS_SUCCESS if the record was loaded
+ ***********************************************************************************/
+TEMPHIST_STATUS tempHistRestore(const TEMPHIST_RECORD * Record)
+{
+  if (Record == 0)
+  {
+    return TEMPHIST_STATUS_INVALID_PARAM;
+  }
+
+  if (Record->Magic != TEMPHIST_MAGIC ||
+      Record->Version != TEMPHIST_VERSION ||
+      Record->NumBuckets != TEMPHIST_NUM_BUCKETS ||
+      Record->MinF != TEMPHIST_MIN_F ||
+      Record->WidthF != TEMPHIST_WIDTH_F ||
+      Record->Check != recordCheck(Record))
+  {
+    return TEMPHIST_STATUS_INVALID_RECORD;
+  }
+
+  tempHistTotal = 0;
+  for (unsigned char i = 0; i < TEMPHIST_NUM_BUCKETS; i++)
+  {
+    tempHist.Seconds[i] = Record->Seconds[i];
+    tempHistTotal += Record->Seconds[i];
+  }
+
+  return TEMPHIST_STATUS_SUCCESS;
+}
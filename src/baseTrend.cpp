@@ -0,0 +1,264 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   baseTrend.cpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Definitions for the rate-of-change estimator and the predictive
+*   over-temperature alarm
+*
+*   The slope is a least-squares fit over the last TREND_WINDOW_SEC
+*   per-second buckets of the history store, with x = bucket position in
+*   the window (0 = oldest) and y = bucket mean. The window spans seconds
+*   no matter how fast the loop runs. A bucket mean averages every raw
+*   sample in its second, so the 1 F steps of the integer samples do not
+*   turn into slope. Only the running sums Sy and Sxy are kept, and the
+*   bucket leaving the window is read back from the store, so each update
+*   is O(1):
+*
+*     Sy'  = Sy - y_old + y_new
+*     Sxy' = Sxy - (Sy - y_old) + (N - 1) * y_new
+*
+*   Sx and Sxx only depend on N and are computed when needed.
+*
+*/
+
+#include "baseTrend.hpp"
+
+#define BUCKET_AGE_SEC          1.0f        // Newest closed bucket's midpoint is ~1 s old on average
+
+unsigned long trendSeen = 0;                // Per-second buckets the window has taken in
+unsigned char trendCount = 0;               // Number of buckets in the window
+
+long trendSumY = 0;                         // Sum of bucket means in the window
+long trendSumXY = 0;                        // Sum of position * bucket mean in the window
+
+float trendSlope = 0;                       // Degrees F per second
+int trendPrediction = 0;                    // Predicted temperature TREND_HORIZON_SEC from now
+
+TREND_ALARM_STATE trendAlarm = TREND_ALARM_CLEAR;
+unsigned long trendAlarmSetMs = 0;
+
+
+/***********************************************************************************
+ * @brief - updateSlope()
+ *  Recomputes the slope and the fitted latest value from the running sums.
+ *
+ * @return - float: Fitted value at the newest bucket position
+ ***********************************************************************************/
+static float updateSlope()
+{
+  float n = trendCount;
+  float sumX = n * (n - 1) / 2;
+  float sumXX = (n - 1) * n * (2 * n - 1) / 6;
+  float denom = n * sumXX - sumX * sumX;
+
+  if (trendCount < 2 || denom == 0)
+  {
+    trendSlope = 0;
+    return trendCount ? float(trendSumY) / n : 0;
+  }
+
+  // One bucket per second, so the slope per position is already per second
+  trendSlope = (n * float(trendSumXY) - sumX * float(trendSumY)) / denom;
+
+  // Regression line passes through (mean x, mean y)
+  return float(trendSumY) / n + trendSlope * ((n - 1) - sumX / n);
+}
+
+
+// Appends a bucket mean while the window is still filling
+static void windowAppend(int16_t Mean)
+{
+  trendSumXY += long(trendCount) * Mean;
+  trendSumY += Mean;
+  trendCount++;
+}
+
+
+/***********************************************************************************
+ * @brief - windowRefill()
+ *  Rebuilds the sums from the newest buckets in the store. Only needed when more
+ *    than one bucket closed since the last sample, after a back-filled gap or
+ *    historyInit(). O(TREND_WINDOW_SEC).
+ *
+ * @return - None
+ ***********************************************************************************/
+static void windowRefill()
+{
+  unsigned char num = historyGetNumBuckets(HIST_TIER_SECONDS);
+  HIST_BUCKET bucket;
+
+  if (num > TREND_WINDOW_SEC)
+  {
+    num = TREND_WINDOW_SEC;
+  }
+
+  trendCount = 0;
+  trendSumY = 0;
+  trendSumXY = 0;
+  while (num-- > 0)
+  {
+    historyGetBucket(HIST_TIER_SECONDS, num, &bucket);
+    windowAppend(bucket.Mean);
+  }
+}
+
+
+/***********************************************************************************
+ * @brief - windowUpdate()
+ *  Takes in the per-second buckets closed since the last call.
+ *
+ * @return - bool: True if the window changed
+ ***********************************************************************************/
+static bool windowUpdate()
+{
+  unsigned long closed = historyGetNumClosed(HIST_TIER_SECONDS);
+  HIST_BUCKET newest, oldest;
+
+  if (closed == trendSeen)
+  {
+    return false;
+  }
+
+  if (closed - trendSeen != 1 || historyGetBucket(HIST_TIER_SECONDS, 0, &newest) != HIST_STATUS_SUCCESS)
+  {
+    windowRefill();
+  }
+  else if (trendCount < TREND_WINDOW_SEC)
+  {
+    windowAppend(newest.Mean);
+  }
+  else if (historyGetBucket(HIST_TIER_SECONDS, TREND_WINDOW_SEC, &oldest) == HIST_STATUS_SUCCESS)
+  {
+    trendSumXY -= trendSumY - oldest.Mean;
+    trendSumXY += long(TREND_WINDOW_SEC - 1) * newest.Mean;
+    trendSumY += newest.Mean - oldest.Mean;
+  }
+  else
+  {
+    windowRefill();
+  }
+
+  trendSeen = closed;
+  return true;
+}
+
+
+/***************************************************************************************
+ * Empties the estimation window and clears the alarm.
+ ***************************************************************************************/
+void trendInit()
+{
+  trendSeen = historyGetNumClosed(HIST_TIER_SECONDS);
+  trendCount = 0;
+  trendSumY = 0;
+  trendSumXY = 0;
+  trendSlope = 0;
+  trendPrediction = 0;
+  trendAlarm = TREND_ALARM_CLEAR;
+  trendAlarmSetMs = 0;
+}
+
+
+/***********************************************************************************
+ * @brief - trendAddSample()
+ *  Re-evaluates the alarm for a raw temperature sample. Call it right after
+ *    historyAddSample() with the same sample, the slope is refitted whenever that
+ *    closed a per-second bucket. Should be fed unsmoothed samples so that alarm
+ *    latency is not tied to the display's rolling average.
+ *
+ *  The alarm sets when the sample is at or above TREND_ALARM_TEMP_F, or when the
+ *    trend line predicts it will be within TREND_HORIZON_SEC. The prediction is
+ *    made from the fitted value of the newest bucket, carried forward by its age
+ *    plus the horizon. Predictions are only trusted once the window is full, a
+ *    few buckets give a very noisy slope. It clears once both the sample and the
+ *    prediction are TREND_ALARM_HYST_F below the threshold.
+ *
+ * @param - Temp: Raw temperature sample
+ * @param - NowMs: Current time in ms, normally millis()
+ *
+ * @return - TREND_ALARM_STATE: Alarm state after this sample
+ ***********************************************************************************/
+TREND_ALARM_STATE trendAddSample(int Temp, unsigned long NowMs)
+{
+  if (windowUpdate())
+  {
+    float fitted = updateSlope();
+    trendPrediction = int(fitted + trendSlope * (BUCKET_AGE_SEC + TREND_HORIZON_SEC));
+  }
+
+  if (Temp >= TREND_ALARM_TEMP_F)
+  {
+    if (trendAlarm == TREND_ALARM_CLEAR)
+    {
+      trendAlarmSetMs = NowMs;
+    }
+    trendAlarm = TREND_ALARM_OVER_TEMP;
+  }
+  else if (trendCount == TREND_WINDOW_SEC && trendPrediction >= TREND_ALARM_TEMP_F)
+  {
+    if (trendAlarm == TREND_ALARM_CLEAR)
+    {
+      trendAlarmSetMs = NowMs;
+    }
+    trendAlarm = TREND_ALARM_PREDICTED;
+  }
+  else if (trendAlarm != TREND_ALARM_CLEAR &&
+           Temp < TREND_ALARM_TEMP_F - TREND_ALARM_HYST_F &&
+           trendPrediction < TREND_ALARM_TEMP_F - TREND_ALARM_HYST_F)
+  {
+    trendAlarm = TREND_ALARM_CLEAR;
+  }
+
+  return trendAlarm;
+}
+
+
+/***********************************************************************************
+ * @brief - trendGetSlope()
+ *  Gets the current rate of change.
+ *
+ * @return - float: Degrees F per second. Zero until two buckets have closed.
+ ***********************************************************************************/
+float trendGetSlope()
+{
+  return trendSlope;
+}
+
+
+/***********************************************************************************
+ * @brief - trendGetPrediction()
+ *  Gets the temperature the trend line predicts TREND_HORIZON_SEC from now.
+ *
+ * @return - int: Predicted temperature in F
+ ***********************************************************************************/
+int trendGetPrediction()
+{
+  return trendPrediction;
+}
+
+
+/***********************************************************************************
+ * @brief - trendGetAlarm()
+ *  Gets the current alarm state.
+ *
+ * @return - TREND_ALARM_STATE: Current alarm state
+ ***********************************************************************************/
+TREND_ALARM_STATE trendGetAlarm()
+{
+  return trendAlarm;
+}
+
+
+/***********************************************************************************
+ * @brief - trendGetAlarmSetMs()
+ *  Gets the time of the sample that last moved the alarm out of the clear state.
+ *    Compare against the time of the raw sample that crossed the threshold to
+ *    get alarm latency.
+ *
+ * @return - unsigned long: Time in ms, as passed to trendAddSample()
+ ***********************************************************************************/
+unsigned long trendGetAlarmSetMs()
+{
+  return trendAlarmSetMs;
+}
@@ -0,0 +1,224 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   halCapture.cpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Definitions for streaming the live OLED framebuffer over the
+*   serial port
+*
+*/
+
+#include "halCapture.hpp"
+#include "halDisplay.hpp"
+
+#define FRAME_BYTES         (SCREEN_WIDTH * SCREEN_HEIGHT / 8)
+#define MAX_REPS            0xFF
+
+bool captureOnce = false;
+bool captureContinuous = false;
+bool captureFrameDone = false;      // A record went out from the send path since the last captureService()
+unsigned char captureSeq = 0;
+
+#ifndef DISPLAY_PAGE_MODE
+unsigned char capturePrevFrame[FRAME_BYTES];                        // Frame sent in the last record
+unsigned char captureRecord[FRAME_BYTES];                           // Delta payload being built
+unsigned char recordsSinceKeyframe = CAPTURE_KEYFRAME_INTERVAL;     // Forces a keyframe first
+
+
+/***********************************************************************************
+ * @brief - encodeDelta()
+ *  XORs the frame against capturePrevFrame, run-length encodes the result into
+ *    the record payload and updates capturePrevFrame. Gives up as soon as the
+ *    encoding would be bigger than a keyframe.
+ *
+ * @param - Frame: Current framebuffer
+ *
+ * @return - unsigned int: Payload length, or 0 if a keyframe should be sent instead
+ ***********************************************************************************/
+static unsigned int encodeDelta(const unsigned char * Frame)
+{
+    unsigned char * out = captureRecord;
+    unsigned int len = 0;
+    unsigned char value = Frame[0] ^ capturePrevFrame[0];
+    unsigned char reps = 0;
+
+    for (unsigned int i = 0; i < FRAME_BYTES; i++)
+    {
+        unsigned char delta = Frame[i] ^ capturePrevFrame[i];
+
+        if (delta != value || reps == MAX_REPS)
+        {
+            if (len + 2 > FRAME_BYTES)
+            {
+                return 0;
+            }
+            out[len++] = value;
+            out[len++] = reps;
+            value = delta;
+            reps = 0;
+        }
+        reps++;
+    }
+
+    if (len + 2 > FRAME_BYTES)
+    {
+        return 0;
+    }
+    out[len++] = value;
+    out[len++] = reps;
+
+    memcpy(capturePrevFrame, Frame, FRAME_BYTES);
+    return len;
+}
+
+
+/***********************************************************************************
+ * @brief - sendRecord()
+ *  Sends the current framebuffer as a delta record, or as a keyframe when the delta
+ *    would not be smaller.
+ *
+ * @return - None
+ ***********************************************************************************/
+static void sendRecord()
+{
+    const unsigned char * frame = display.getBuffer();
+    unsigned int len = 0;
+
+    if (recordsSinceKeyframe < CAPTURE_KEYFRAME_INTERVAL)
+    {
+        len = encodeDelta(frame);
+    }
+    recordsSinceKeyframe++;
+
+    if (len > 0)
+    {
+        captureWriteRecord(CAPTURE_TYPE_DELTA, captureRecord, len);
+    }
+    else
+    {
+        memcpy(capturePrevFrame, frame, FRAME_BYTES);
+        recordsSinceKeyframe = 1;
+        captureWriteRecord(CAPTURE_TYPE_KEYFRAME, frame, FRAME_BYTES);
+    }
+}
+#endif
+
+
+/***********************************************************************************
+ * @brief - captureWriteRecord()
+ *  Frames a payload as a capture record and writes it. Nothing else is printed
+ *    between the three writes, so debug text can only land between records.
+ *
+ * @param - Type: What the payload holds
+ * @param - Payload: Record payload
+ * @param - Len: Payload length in bytes
+ *
+ * @return - None
+ ***********************************************************************************/
+void captureWriteRecord(CAPTURE_TYPE Type, const unsigned char * Payload, unsigned int Len)
+{
+    unsigned char header[CAPTURE_HEADER_LEN];
+    unsigned char check = 0;
+
+    for (unsigned int i = 0; i < Len; i++)
+    {
+        check ^= Payload[i];
+    }
+
+    header[0] = CAPTURE_SYNC_0;
+    header[1] = CAPTURE_SYNC_1;
+    header[2] = Type;
+    header[3] = captureSeq++;
+    header[4] = Len & 0xFF;
+    header[5] = Len >> 8;
+
+    Serial.write(header, CAPTURE_HEADER_LEN);
+    Serial.write(Payload, Len);
+    Serial.write(check);
+}
+
+
+/***********************************************************************************
+ * @brief - captureRequest()
+ *  Asks for the framebuffer to be sent on the next captureService() call.
+ *    Refused in DISPLAY_PAGE_MODE, where there is no framebuffer. Streaming would
+ *    only keep the status text off the port without ever sending a record.
+ *
+ * @param - Continuous: Keep sending a record for every frame pushed, and every
+ *                      captureService() call, until captureStop() is called
+ *
+ * @return - bool: False if this build can't capture
+ ***********************************************************************************/
+bool captureRequest(bool Continuous)
+{
+#ifdef DISPLAY_PAGE_MODE
+    (void)Continuous;
+    return false;
+#else
+    captureOnce = true;
+    captureContinuous = Continuous;
+    return true;
+#endif
+}
+
+
+void captureStop()
+{
+    captureOnce = false;
+    captureContinuous = false;
+}
+
+
+/***********************************************************************************
+ * @brief - captureIsStreaming()
+ *  Lets callers keep chatty text output off the port while frames are streamed.
+ *
+ * @return - bool: True while continuous capture is on
+ ***********************************************************************************/
+bool captureIsStreaming()
+{
+    return captureContinuous;
+}
+
+
+/***********************************************************************************
+ * @brief - captureService()
+ *  Sends a record if one has been requested. Call once per loop(), after the
+ *    frame has been pushed to the panel. While streaming, a frame already sent
+ *    by captureFrameSent() since the last call isn't sent again. Static screens
+ *    cost about 10 bytes per record. Does nothing in DISPLAY_PAGE_MODE, where
+ *    there is no framebuffer.
+ *
+ * @return - None
+ ***********************************************************************************/
+void captureService()
+{
+#ifndef DISPLAY_PAGE_MODE
+    if (captureOnce || (captureContinuous && !captureFrameDone))
+    {
+        sendRecord();
+        captureOnce = false;
+    }
+    captureFrameDone = false;
+#endif
+}
+
+
+/***********************************************************************************
+ * @brief - captureFrameSent()
+ *  Called by halDisplay each time a frame has been pushed to the panel. While
+ *    streaming, sends that frame right away, so animations that block loop()
+ *    (blinks, the dial's needle easing) are captured frame by frame.
+ *
+ * @return - None
+ ***********************************************************************************/
+void captureFrameSent()
+{
+#ifndef DISPLAY_PAGE_MODE
+    if (captureContinuous)
+    {
+        sendRecord();
+        captureFrameDone = true;
+    }
+#endif
+}
@@ -8,14 +8,370 @@
 */
 
 #include "halDisplay.hpp"
+#include "halCapture.hpp"
 #include "baseChibis.hpp"
 
-#ifndef __AVR__
-//TwoWire myWire(&sercom2, 9, 10);  // SDA = A9, SCL = A10
+#define SERIAL_PAD_LINES  3
+#define FPS_WINDOW_FRAMES 32        // Panel frames averaged by displayGetFps()
+#define FRAME_BYTES       (SCREEN_WIDTH * SCREEN_HEIGHT / 8)
+#define BLINK_PERIOD_MS   1000      // displayBlinkChibi(): 500 ms on, 500 ms off
+#define EFFECT_FADE_STEPS 16        // Contrast levels in a fade or wipe
+#define LAYER_MAX_WINDOWS (SSD1306_NUM_PAGES + 8)   // A needle span per page plus the readout regions
+
+// Block of columns over whole pages, the unit the panel is written in
+typedef struct _LAYER_WINDOW
+{
+    int16_t X0;
+    int16_t X1;
+    unsigned char Page0;
+    unsigned char Page1;
+} LAYER_WINDOW, *PTR_LAYER_WINDOW;
+
+#ifdef DISPLAY_PAGE_MODE
+PageCanvas pageCanvas;
+#elif defined(DISPLAY_LEAN_DRIVER)
+LeanSSD1306 display;
+#else
+Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET, SSD1306_I2C_CLOCK_HZ);
 #endif
 
-#define SERIAL_PAD_LINES  3
-Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
+#ifdef DISPLAY2_SERCOM
+#define DISPLAY2_TX_TIMEOUT_MS  50      // A 1 KB frame takes ~23 ms at 400 kHz
+
+TwoWire wire2(&DISPLAY2_SERCOM, DISPLAY2_SDA_PIN, DISPLAY2_SCL_PIN);
+Adafruit_SSD1306 display2(SCREEN_WIDTH, SCREEN_HEIGHT, &wire2, OLED_RESET,
+                          DISPLAY2_I2C_CLOCK_HZ, DISPLAY2_I2C_CLOCK_HZ);
+
+// Frame being sent to the second panel from the SERCOM interrupt
+volatile bool display2TxBusy = false;
+volatile bool display2TxControl = false;        // Control byte still to send
+const unsigned char * volatile display2TxData = 0;
+volatile unsigned int display2TxLeft = 0;       // Data bytes still to send in the current page
+volatile unsigned char display2TxPages = 0;     // Pages of the window still to start
+unsigned char display2TxWidth = 0;              // Bytes per page of the window
+unsigned long display2TxStartMs = 0;
+
+
+// Ends the interrupt-driven transfer with a stop condition
+static void display2TxStop()
+{
+    SercomI2cm * i2c = &DISPLAY2_SERCOM_REGS->I2CM;
+
+    i2c->INTENCLR.reg = SERCOM_I2CM_INTENCLR_MB | SERCOM_I2CM_INTENCLR_ERROR;
+    i2c->INTFLAG.reg = SERCOM_I2CM_INTFLAG_ERROR;
+    i2c->CTRLB.bit.CMD = 3;     // Stop
+    while (i2c->SYNCBUSY.bit.SYSOP);
+    display2TxBusy = false;
+}
+
+
+/***********************************************************************************
+ * @brief - display2TxService()
+ *  Feeds one byte to the second panel's bus. Runs from SERCOM0_Handler() each
+ *    time the master has finished the previous byte (MB), so the frame goes out
+ *    while the main panel's flush keeps the CPU busy on its own SERCOM. At the
+ *    end of each page of the window it skips to the same columns one page down.
+ *
+ * @return - None
+ ***********************************************************************************/
+static void display2TxService()
+{
+    SercomI2cm * i2c = &DISPLAY2_SERCOM_REGS->I2CM;
+
+    if (i2c->INTFLAG.bit.ERROR || i2c->STATUS.bit.RXNACK ||
+        (!display2TxControl && display2TxLeft == 0 && display2TxPages == 0))
+    {
+        display2TxStop();
+    }
+    else if (display2TxControl)
+    {
+        display2TxControl = false;
+        i2c->DATA.reg = SSD1306_CTRL_DATA;
+    }
+    else
+    {
+        if (display2TxLeft == 0)
+        {
+            display2TxData = display2TxData + (SCREEN_WIDTH - display2TxWidth);
+            display2TxLeft = display2TxWidth;
+            display2TxPages = display2TxPages - 1;
+        }
+        i2c->DATA.reg = *display2TxData;
+        display2TxData = display2TxData + 1;
+        display2TxLeft = display2TxLeft - 1;
+    }
+}
+
+
+void SERCOM0_Handler()
+{
+    if (display2TxBusy)
+    {
+        display2TxService();
+    }
+    else
+    {
+        wire2.onService();
+    }
+}
+
+
+/***********************************************************************************
+ * @brief - display2Wait()
+ *  Waits for the second panel's frame to finish. Anything that touches wire2 or
+ *    display2's buffer has to call it first. Gives up on a stuck bus after
+ *    DISPLAY2_TX_TIMEOUT_MS.
+ *
+ * @return - None
+ ***********************************************************************************/
+static void display2Wait()
+{
+    while (display2TxBusy)
+    {
+        if (millis() - display2TxStartMs > DISPLAY2_TX_TIMEOUT_MS)
+        {
+            noInterrupts();
+            if (display2TxBusy)
+            {
+                display2TxStop();
+            }
+            interrupts();
+        }
+    }
+}
+
+
+/***********************************************************************************
+ * @brief - display2Send()
+ *  Starts sending a window of display2's buffer and returns right away, the
+ *    SERCOM interrupt sends the bytes. Same window commands and data stream as
+ *    Adafruit_SSD1306::display(), in a single transaction.
+ *
+ * @param - X0, X1: First and last column of the window
+ * @param - Page0, Page1: First and last page of the window
+ *
+ * @return - None
+ ***********************************************************************************/
+static void display2Send(int16_t X0, int16_t X1, unsigned char Page0, unsigned char Page1)
+{
+    SercomI2cm * i2c = &DISPLAY2_SERCOM_REGS->I2CM;
+
+    display2Wait();
+    display2.ssd1306_command(SSD1306_CMD_SET_PAGE_ADDR);
+    display2.ssd1306_command(Page0);
+    display2.ssd1306_command(Page1);
+    display2.ssd1306_command(SSD1306_CMD_SET_COL_ADDR);
+    display2.ssd1306_command(X0);
+    display2.ssd1306_command(X1);
+
+    display2TxData = display2.getBuffer() + Page0 * SCREEN_WIDTH + X0;
+    display2TxWidth = X1 - X0 + 1;
+    display2TxLeft = display2TxWidth;
+    display2TxPages = Page1 - Page0;
+    display2TxControl = true;
+    display2TxStartMs = millis();
+    display2TxBusy = true;
+
+    i2c->INTFLAG.reg = SERCOM_I2CM_INTFLAG_ERROR;
+    i2c->INTENSET.reg = SERCOM_I2CM_INTENSET_MB | SERCOM_I2CM_INTENSET_ERROR;
+    while (i2c->SYNCBUSY.bit.SYSOP);
+    i2c->ADDR.reg = SERCOM_I2CM_ADDR_ADDR(SSD1306_I2C_ADDR << 1);     // Start, write
+}
+#endif
+
+unsigned long fpsWindowStartUs = 0;     // Aggregate panel frames per second, both panels counted
+unsigned char fpsFrames = 0;
+float fpsLast = 0;
+
+int alertTemp = 0;                  // Values shown by drawAlertValues()
+int alertSlopeTenths = 0;           // F/s * 10, so equal values always print the same
+#ifdef DISPLAY_PAGE_MODE
+bool alertOnPanel = false;          // The panel shows the alert with the values above
+#endif
+
+DISPLAY_EFFECT effect = DISPLAY_EFFECT_NONE;    // Effect being run by displayEffectsService()
+unsigned int effectPeriodMs = 0;
+unsigned char effectCount = 0;              // Blinks or flashes, 0 = until stopped
+unsigned int effectStep = 0;                // Last step sent
+unsigned long effectStartMs = 0;
+bool effectPanelOff = false;                // Panel state left behind by effects
+bool effectInverted = false;
+bool effectDimmed = false;
+bool effectWakePending = false;             // Turn the panel on once the next frame is sent
+
+const DISPLAY_LAYOUT * layerFull = 0;       // Layout drawn by drawLayoutFull()
+#ifndef DISPLAY_PAGE_MODE
+const DISPLAY_LAYOUT * layerCached = 0;     // Layout whose background is in layerBackground
+unsigned char layerBackground[FRAME_BYTES]; // Background layer, drawn once per layout
+unsigned char layerShown[FRAME_BYTES];      // What the panel shows, to skip unchanged regions
+LAYER_WINDOW layerWindows[LAYER_MAX_WINDOWS];   // Changed windows of the frame, sent by layerFinish()
+unsigned char layerNumWindows = 0;
+#endif
+
+#if defined(DISPLAY2_SERCOM) && DISPLAY2_MIRROR && !defined(DISPLAY_PAGE_MODE)
+LAYER_WINDOW mirrorPending;                 // Area the second panel is behind on
+bool mirrorDirty = false;
+#endif
+
+const DISPLAY_DIAL * dialFull = 0;          // Dial drawn by drawDialFull()
+int16_t dialFullAngle = 0;
+#ifndef DISPLAY_PAGE_MODE
+int16_t dialShownAngle = 0;                 // Needle on the panel, valid while the dial's layout is cached
+int16_t dialSpanX0[SSD1306_NUM_PAGES];      // Columns touched by the needle this frame, per page.
+int16_t dialSpanX1[SSD1306_NUM_PAGES];      // X0 > X1 when the page wasn't touched.
+#endif
+
+
+#ifdef DISPLAY_PAGE_MODE
+/***********************************************************************************
+ * PageCanvas
+ *  Adafruit_GFX target backed by a single page buffer. displayRender() runs the
+ *    draw function once per page, so the whole screen costs 128 bytes of SRAM
+ *    instead of the 1 KB the Adafruit driver allocates.
+ ***********************************************************************************/
+PageCanvas::PageCanvas() : Adafruit_GFX(SCREEN_WIDTH, SCREEN_HEIGHT), pageY0(0)
+{
+    memset(buffer, 0, sizeof(buffer));
+}
+
+void PageCanvas::setPage(unsigned char Page)
+{
+    pageY0 = Page * 8;
+    memset(buffer, 0, sizeof(buffer));
+}
+
+unsigned char * PageCanvas::getBuffer()
+{
+    return buffer;
+}
+
+void PageCanvas::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (x < 0 || x >= SCREEN_WIDTH || y < pageY0 || y >= pageY0 + 8)
+    {
+        return;
+    }
+
+    unsigned char bit = 1 << (y - pageY0);
+    switch (color)
+    {
+        case SSD1306_WHITE:   buffer[x] |= bit;  break;
+        case SSD1306_BLACK:   buffer[x] &= ~bit; break;
+        case SSD1306_INVERSE: buffer[x] ^= bit;  break;
+    }
+}
+
+// Text at size > 1 is drawn as filled rects, so clip them to the page in one go
+// rather than falling back to per-pixel drawPixel() calls.
+void PageCanvas::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    int16_t y0 = (y > pageY0) ? y : pageY0;
+    int16_t y1 = (y + h < pageY0 + 8) ? y + h : pageY0 + 8;
+    int16_t x0 = (x > 0) ? x : 0;
+    int16_t x1 = (x + w < SCREEN_WIDTH) ? x + w : SCREEN_WIDTH;
+
+    if (y0 >= y1 || x0 >= x1)
+    {
+        return;
+    }
+
+    unsigned char mask = (unsigned char)(((1 << (y1 - y0)) - 1) << (y0 - pageY0));
+    for (int16_t i = x0; i < x1; i++)
+    {
+        switch (color)
+        {
+            case SSD1306_WHITE:   buffer[i] |= mask;  break;
+            case SSD1306_BLACK:   buffer[i] &= ~mask; break;
+            case SSD1306_INVERSE: buffer[i] ^= mask;  break;
+        }
+    }
+}
+
+void PageCanvas::fillScreen(uint16_t color)
+{
+    fillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, color);
+}
+#endif
+
+
+/***********************************************************************************
+ * Draw functions for the screens owned by this module
+ ***********************************************************************************/
+static void drawBlank(Adafruit_GFX &)
+{
+}
+
+static void drawHappyChibi(Adafruit_GFX & Gfx)
+{
+    Gfx.drawBitmap(0, 0, BLANK_CHIBI, 128, 60, WHITE);
+}
+
+// Both layers in one pass, for page mode and for comparing against the cached path
+static void drawLayoutFull(Adafruit_GFX & Gfx)
+{
+    layerFull->Background(Gfx);
+    layerFull->Dynamic(Gfx);
+}
+
+static void plotGfx(int16_t X, int16_t Y, void * Ctx)
+{
+    ((Adafruit_GFX *)Ctx)->drawPixel(X, Y, SSD1306_WHITE);
+}
+
+static void dialDrawNeedle(const DISPLAY_DIAL * Dial, int16_t Angle, DIAL_PLOT_FN Plot, void * Ctx)
+{
+    int16_t x0, y0, x1, y1;
+
+    dialPoint(Dial->CenterX, Dial->CenterY, Dial->NeedleStart, Angle, &x0, &y0);
+    dialPoint(Dial->CenterX, Dial->CenterY, Dial->NeedleEnd, Angle, &x1, &y1);
+    dialRasterLine(x0, y0, x1, y1, Plot, Ctx);
+}
+
+// Face, readout and needle in one pass, for page mode and for comparing against the incremental path
+static void drawDialFull(Adafruit_GFX & Gfx)
+{
+    dialFull->Layout.Background(Gfx);
+    dialFull->Layout.Dynamic(Gfx);
+    dialDrawNeedle(dialFull, dialFullAngle, plotGfx, &Gfx);
+}
+
+// "HOT!" at size 3 is 4 x 18 = 72 px wide and 24 px high, centered above the values.
+// Wrap is off so nothing can spill into the value regions.
+static void drawAlertBackground(Adafruit_GFX & Gfx)
+{
+    Gfx.fillScreen(SSD1306_WHITE);
+    Gfx.setTextWrap(false);
+    Gfx.setTextColor(SSD1306_BLACK);
+    Gfx.setTextSize(3);
+    Gfx.setCursor((SCREEN_WIDTH - 4 * 18) / 2, 2);
+    Gfx.print(F("HOT!"));
+}
+
+// Black on the white background, the units move with the width of the values
+static void drawAlertValues(Adafruit_GFX & Gfx)
+{
+    Gfx.setTextWrap(false);
+    Gfx.setTextColor(SSD1306_BLACK);
+    Gfx.setTextSize(2);
+    Gfx.setCursor(10, 30);
+    Gfx.print(alertTemp);
+    Gfx.print('F');
+    Gfx.setCursor(10, 48);
+    Gfx.print(alertSlopeTenths / 10.0f, 1);
+    Gfx.print(F("F/s"));
+}
+
+// 12 x 16 px per character at text size 2. Room for "-999F" and "-999.9F/s" (9 x 12 = 108 px),
+// below the banner's rows 2..25
+const DISPLAY_REGION ALERT_REGIONS[] = {
+    { 10, 30, 108, 16 },
+    { 10, 48, 108, 16 },
+};
+
+const DISPLAY_LAYOUT ALERT_LAYOUT = {
+    drawAlertBackground, drawAlertValues,
+    ALERT_REGIONS, sizeof(ALERT_REGIONS) / sizeof(ALERT_REGIONS[0])
+};
 
 /***************************************************************************************
  * @brief - displayInit()
@@ -27,6 +383,10 @@ Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
  ***************************************************************************************/
 void displayInit()
 {
+#ifdef DISPLAY_PAGE_MODE
+    // Nothing to allocate in page mode
+    ssd1306Init(SSD1306_SWITCHCAPVCC, SSD1306_I2C_ADDR);
+#else
     // I2C address 0x3C is typical for 0.96" OLEDs
     if(!display.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
         // Hang firmware and continuously send serial output
@@ -37,46 +397,1060 @@ void displayInit()
             delay(1000);
         }
     }
+#endif
+
+#ifdef DISPLAY2_SERCOM
+    // wire2.begin() resets the pin mux, so route the pins after it and keep
+    // display2.begin() from starting the bus again
+    wire2.begin();
+    pinPeripheral(DISPLAY2_SDA_PIN, PIO_SERCOM_ALT);
+    pinPeripheral(DISPLAY2_SCL_PIN, PIO_SERCOM_ALT);
+    if(!display2.begin(SSD1306_SWITCHCAPVCC, 0x3C, true, false)) {
+        while (true)
+        {
+            Serial.println(F("SSD1306 #2 allocation failed"));
+            delay(1000);
+        }
+    }
+#endif
+
+    fpsWindowStartUs = micros();
 }
 
 
 /***********************************************************************************
- * @brief - displayPrintHappyChibi()
- *  Just prints happy chibi to the OLED.
- * 
+ * @brief - countFrames()
+ *  Counts panel frames pushed and updates the aggregate frame rate every
+ *    FPS_WINDOW_FRAMES frames.
+ *
+ * @param - Frames: Number of panel frames just pushed
+ *
  * @return - None
  ***********************************************************************************/
-void displayPrintHappyChibi()
+static void countFrames(unsigned char Frames)
+{
+    fpsFrames += Frames;
+    if (fpsFrames >= FPS_WINDOW_FRAMES)
+    {
+        unsigned long nowUs = micros();
+        fpsLast = float(fpsFrames) * 1000000.0 / float(nowUs - fpsWindowStartUs);
+        fpsWindowStartUs = nowUs;
+        fpsFrames = 0;
+    }
+}
+
+
+/***********************************************************************************
+ * @brief - displayGetFps()
+ *  Gets the aggregate number of panel frames pushed per second. With two panels
+ *    each frame pushed to each panel counts once.
+ *
+ * @return - float: Frames per second over the last FPS_WINDOW_FRAMES frames
+ ***********************************************************************************/
+float displayGetFps()
+{
+    return fpsLast;
+}
+
+
+#ifndef DISPLAY_PAGE_MODE
+/***********************************************************************************
+ * @brief - regionBounds()
+ *  Clips a region to the screen and widens it to whole pages.
+ *
+ * @return - bool: False if nothing is left after clipping
+ ***********************************************************************************/
+static bool regionBounds(const DISPLAY_REGION * Region, int16_t * X0, int16_t * X1,
+                         unsigned char * Page0, unsigned char * Page1)
+{
+    int16_t y0 = max(Region->Y, (int16_t)0);
+    int16_t y1 = min((int16_t)(Region->Y + Region->H), (int16_t)SCREEN_HEIGHT) - 1;
+
+    *X0 = max(Region->X, (int16_t)0);
+    *X1 = min((int16_t)(Region->X + Region->W), (int16_t)SCREEN_WIDTH) - 1;
+    if (*X0 > *X1 || y0 > y1)
+    {
+        return false;
+    }
+
+    *Page0 = y0 >> 3;
+    *Page1 = y1 >> 3;
+    return true;
+}
+
+
+// Grows Window to cover the given one as well
+static void windowUnion(PTR_LAYER_WINDOW Window, int16_t X0, int16_t X1, unsigned char Page0, unsigned char Page1)
+{
+    Window->X0 = min(Window->X0, X0);
+    Window->X1 = max(Window->X1, X1);
+    Window->Page0 = min(Window->Page0, Page0);
+    Window->Page1 = max(Window->Page1, Page1);
+}
+
+
+// Adds a changed area of the main panel to what the mirrored second panel still needs
+static void mirrorMark(int16_t X0, int16_t X1, unsigned char Page0, unsigned char Page1)
+{
+  #if defined(DISPLAY2_SERCOM) && DISPLAY2_MIRROR
+    if (!mirrorDirty)
+    {
+        mirrorPending.X0 = X0;
+        mirrorPending.X1 = X1;
+        mirrorPending.Page0 = Page0;
+        mirrorPending.Page1 = Page1;
+        mirrorDirty = true;
+    }
+    else
+    {
+        windowUnion(&mirrorPending, X0, X1, Page0, Page1);
+    }
+  #else
+    (void)X0;
+    (void)X1;
+    (void)Page0;
+    (void)Page1;
+  #endif
+}
+
+
+/***********************************************************************************
+ * @brief - mirrorService()
+ *  Starts pushing the area of the main panel's buffer that changed since the last
+ *    push to the mirrored second panel. The copy goes out from the SERCOM
+ *    interrupt, so call this before flushing the main panel and both buses run
+ *    at the same time.
+ *
+ *  Only one transfer is in flight at a time. If the last one is still going out
+ *    this returns without waiting, unless Wait is set, and the area keeps growing
+ *    until a later frame or displayEffectsService() finds the bus free. A needle
+ *    animated every 10 ms then costs the second panel a few small windows instead
+ *    of a 1 KB frame, ~23 ms of bus, per step.
+ *
+ * @param - Wait: Wait for the previous transfer instead of skipping this one
+ *
+ * @return - None
+ ***********************************************************************************/
+static void mirrorService(bool Wait)
+{
+  #if defined(DISPLAY2_SERCOM) && DISPLAY2_MIRROR
+    unsigned char * src = display.getBuffer();
+    unsigned char * dst = display2.getBuffer();
+
+    if (!mirrorDirty)
+    {
+        return;
+    }
+
+    // A transfer that ran past the timeout is stuck, display2Wait() ends it
+    if (display2TxBusy && !Wait && millis() - display2TxStartMs <= DISPLAY2_TX_TIMEOUT_MS)
+    {
+        return;
+    }
+
+    display2Wait();
+    for (unsigned char page = mirrorPending.Page0; page <= mirrorPending.Page1; page++)
+    {
+        unsigned int offset = page * SCREEN_WIDTH + mirrorPending.X0;
+        memcpy(&dst[offset], &src[offset], mirrorPending.X1 - mirrorPending.X0 + 1);
+    }
+    display2Send(mirrorPending.X0, mirrorPending.X1, mirrorPending.Page0, mirrorPending.Page1);
+    mirrorDirty = false;
+    countFrames(1);
+  #else
+    (void)Wait;
+  #endif
+}
+
+
+// The whole main panel changed
+static void mirrorFrame(bool Wait)
+{
+    mirrorMark(0, SCREEN_WIDTH - 1, 0, SSD1306_NUM_PAGES - 1);
+    mirrorService(Wait);
+}
+
+
+// Draws a layout's background into the cache, then its dynamic layer on top
+static void layerBuild(const DISPLAY_LAYOUT * Layout)
 {
     display.clearDisplay();
-    display.drawBitmap(0, 0, BLANK_CHIBI, 128, 60, WHITE);
+    Layout->Background(display);
+    memcpy(layerBackground, display.getBuffer(), FRAME_BYTES);
+    Layout->Dynamic(display);
+}
+
+
+// Sends the whole frame and remembers it as what the panel shows for Layout
+static void layerSendAll(const DISPLAY_LAYOUT * Layout)
+{
+    mirrorFrame(false);
     display.display();
+    memcpy(layerShown, display.getBuffer(), FRAME_BYTES);
+    layerCached = Layout;
+    countFrames(1);
+}
+
+
+static void layerRestoreRegions(const DISPLAY_LAYOUT * Layout)
+{
+    unsigned char * frame = display.getBuffer();
+    int16_t x0, x1;
+    unsigned char page0, page1;
+
+    for (unsigned char r = 0; r < Layout->NumRegions; r++)
+    {
+        if (!regionBounds(&Layout->Regions[r], &x0, &x1, &page0, &page1))
+        {
+            continue;
+        }
+
+        for (unsigned char page = page0; page <= page1; page++)
+        {
+            unsigned int offset = page * SCREEN_WIDTH + x0;
+            memcpy(&frame[offset], &layerBackground[offset], x1 - x0 + 1);
+        }
+    }
 }
 
 
 /***********************************************************************************
- * @brief - displayBlinkChibi()
- *  Blinks happy chibi on the OLED screen on and off every 500 ms.
- * 
- * @param - TimeSeconds: Int representing the amount of time to blink for 
- * 
+ * @brief - layerQueueWindow()
+ *  Compares a window of the frame with what the panel shows and updates the copy.
+ *    A changed window is queued for layerFinish(), which sends it on its own. If
+ *    the queue is full the window is merged into the last one queued, which may
+ *    then resend bytes the panel already shows.
+ *
+ * @return - bool: True if any byte in the window changed
+ ***********************************************************************************/
+static bool layerQueueWindow(int16_t X0, int16_t X1, unsigned char Page0, unsigned char Page1)
+{
+    unsigned char * frame = display.getBuffer();
+    bool changed = false;
+
+    for (unsigned char page = Page0; page <= Page1; page++)
+    {
+        unsigned int offset = page * SCREEN_WIDTH + X0;
+        if (memcmp(&frame[offset], &layerShown[offset], X1 - X0 + 1) != 0)
+        {
+            memcpy(&layerShown[offset], &frame[offset], X1 - X0 + 1);
+            changed = true;
+        }
+    }
+
+    if (!changed)
+    {
+        return false;
+    }
+
+    if (layerNumWindows < LAYER_MAX_WINDOWS)
+    {
+        PTR_LAYER_WINDOW window = &layerWindows[layerNumWindows++];
+        window->X0 = X0;
+        window->X1 = X1;
+        window->Page0 = Page0;
+        window->Page1 = Page1;
+    }
+    else
+    {
+        windowUnion(&layerWindows[LAYER_MAX_WINDOWS - 1], X0, X1, Page0, Page1);
+    }
+    mirrorMark(X0, X1, Page0, Page1);
+    return true;
+}
+
+
+/***********************************************************************************
+ * @brief - layerSendWindow()
+ *  Sends a window of the frame to the main panel. The Adafruit driver can only
+ *    send the whole frame, so there the window goes out through
+ *    ssd1306WriteData() from its buffer, on the same bus and address.
+ *
  * @return - None
  ***********************************************************************************/
-void displayBlinkChibi(int TimeSeconds)
+static void layerSendWindow(const LAYER_WINDOW * Window)
 {
-    for (int i = 0; i < TimeSeconds; i++)
+  #ifdef DISPLAY_LEAN_DRIVER
+    display.markDirty(Window->X0, Window->Page0 * 8, Window->X1, Window->Page1 * 8 + 7);
+    display.display();
+  #else
+    unsigned char * frame = display.getBuffer();
+
+    ssd1306SetWindow(Window->X0, Window->X1, Window->Page0, Window->Page1);
+    for (unsigned char page = Window->Page0; page <= Window->Page1; page++)
     {
-        // Blink screen while waiting so that we can show that
-        // firmware is alive.
-        displayPrintHappyChibi();
-        delay(500);
-        display.clearDisplay();
-        display.display();
-        delay(500);
+        ssd1306WriteData(&frame[page * SCREEN_WIDTH + Window->X0], Window->X1 - Window->X0 + 1);
+    }
+  #endif
+}
+
+
+static void layerQueueRegions(const DISPLAY_LAYOUT * Layout)
+{
+    int16_t x0, x1;
+    unsigned char page0, page1;
+
+    for (unsigned char r = 0; r < Layout->NumRegions; r++)
+    {
+        if (regionBounds(&Layout->Regions[r], &x0, &x1, &page0, &page1))
+        {
+            layerQueueWindow(x0, x1, page0, page1);
+        }
     }
 }
 
 
+// Ends an incremental frame by sending its queued windows. The second panel's
+// transfer is started first so it overlaps them. A frame where nothing changed
+// sent nothing, so it isn't counted.
+static void layerFinish()
+{
+    if (layerNumWindows == 0)
+    {
+        return;
+    }
+
+    mirrorService(false);
+    for (unsigned char w = 0; w < layerNumWindows; w++)
+    {
+        layerSendWindow(&layerWindows[w]);
+    }
+    layerNumWindows = 0;
+    countFrames(1);
+}
+
+
+/***********************************************************************************
+ * Needle pixels are written straight into the framebuffer (Ctx). Only pixels that
+ * actually change widen their page's span, so pages the needle didn't move in
+ * aren't compared or sent.
+ ***********************************************************************************/
+static void dialSpanAdd(int16_t X, int16_t Y)
+{
+    unsigned char page = Y >> 3;
+
+    if (X < dialSpanX0[page]) dialSpanX0[page] = X;
+    if (X > dialSpanX1[page]) dialSpanX1[page] = X;
+}
+
+// Puts the background back under one pixel of the old needle
+static void plotErase(int16_t X, int16_t Y, void * Ctx)
+{
+    unsigned char * frame = (unsigned char *)Ctx;
+
+    if (X < 0 || X >= SCREEN_WIDTH || Y < 0 || Y >= SCREEN_HEIGHT)
+    {
+        return;
+    }
+
+    unsigned int i = (Y >> 3) * SCREEN_WIDTH + X;
+    unsigned char mask = 1 << (Y & 7);
+    if ((frame[i] ^ layerBackground[i]) & mask)
+    {
+        frame[i] ^= mask;
+        dialSpanAdd(X, Y);
+    }
+}
+
+static void plotSet(int16_t X, int16_t Y, void * Ctx)
+{
+    unsigned char * frame = (unsigned char *)Ctx;
+
+    if (X < 0 || X >= SCREEN_WIDTH || Y < 0 || Y >= SCREEN_HEIGHT)
+    {
+        return;
+    }
+
+    unsigned int i = (Y >> 3) * SCREEN_WIDTH + X;
+    unsigned char mask = 1 << (Y & 7);
+    if (!(frame[i] & mask))
+    {
+        frame[i] |= mask;
+        dialSpanAdd(X, Y);
+    }
+}
+#endif
+
+
+/***********************************************************************************
+ * Panel commands for the effects. Sent to the mirrored second panel as well.
+ ***********************************************************************************/
+static void effectCommand(unsigned char Cmd)
+{
+#ifdef DISPLAY_PAGE_MODE
+    ssd1306Command(Cmd);
+#else
+    display.ssd1306_command(Cmd);
+#endif
+#if defined(DISPLAY2_SERCOM) && DISPLAY2_MIRROR
+    display2Wait();
+    display2.ssd1306_command(Cmd);
+#endif
+}
+
+static void effectContrast(unsigned char Level)
+{
+    effectCommand(SSD1306_CMD_SET_CONTRAST);
+    effectCommand(Level);
+    effectDimmed = (Level != SSD1306_CONTRAST_NORMAL);
+}
+
+static void effectPanelOn(bool On)
+{
+    effectCommand(On ? SSD1306_CMD_DISPLAY_ON : SSD1306_CMD_DISPLAY_OFF);
+    effectPanelOff = !On;
+}
+
+static bool effectScrolling()
+{
+    return effect == DISPLAY_EFFECT_WIPE_LEFT || effect == DISPLAY_EFFECT_WIPE_RIGHT;
+}
+
+// Panel RAM can't be written while it scrolls, so frames are dropped during a wipe
+static bool effectBlocksFrame()
+{
+    return effectScrolling();
+}
+
+static void effectFrameSent()
+{
+    if (effectWakePending)
+    {
+        effectWakePending = false;
+        effectPanelOn(true);
+    }
+}
+
+// Every path that pushes a frame ends here, so frames drawn inside blocking
+// animations reach the capture stream as well as the panel
+static void frameSent()
+{
+    effectFrameSent();
+    captureFrameSent();
+}
+
+/***********************************************************************************
+ * @brief - displayRender()
+ *  Draws a frame and pushes it to the OLED. With a full framebuffer Draw is
+ *    called once. In DISPLAY_PAGE_MODE it is called once per 128x8 page and each
+ *    page is streamed to the panel before the next one is drawn.
+ * 
+ * @param - Draw: Function that draws the frame
+ * 
+ * @return - None
+ ***********************************************************************************/
+void displayRender(DISPLAY_DRAW_FN Draw)
+{
+    if (effectBlocksFrame())
+    {
+        return;
+    }
+
+#ifdef DISPLAY_PAGE_MODE
+    ssd1306SetWindow(0, SCREEN_WIDTH - 1, 0, SSD1306_NUM_PAGES - 1);
+
+    for (unsigned char page = 0; page < SSD1306_NUM_PAGES; page++)
+    {
+        pageCanvas.setPage(page);
+        Draw(pageCanvas);
+        ssd1306WriteData(pageCanvas.getBuffer(), SSD1306_PAGE_BYTES);
+    }
+    alertOnPanel = (Draw == drawLayoutFull && layerFull == &ALERT_LAYOUT);
+    countFrames(1);
+#else
+    layerCached = 0;    // The background cache no longer matches the panel
+
+    display.clearDisplay();
+    Draw(display);
+
+    // Mirrored: reuse the frame that was just drawn instead of drawing it again
+    mirrorFrame(false);
+    display.display();
+    countFrames(1);
+#endif
+
+    frameSent();
+}
+
+
+/***********************************************************************************
+ * @brief - displayBenchmark()
+ *  Times full-frame flushes of the main panel and prints throughput and latency
+ *    to the serial port. Measures whichever driver and transport this build uses.
+ *    With a mirrored second panel it then times both panels together and prints
+ *    the aggregate panel frames per second. Leaves the screen blank.
+ * 
+ * @param - Frames: Number of full frames to send
+ * 
+ * @return - None
+ ***********************************************************************************/
+void displayBenchmark(unsigned char Frames)
+{
+    unsigned long startUs, elapsedUs;
+
+#ifdef DISPLAY_PAGE_MODE
+    startUs = micros();
+    for (unsigned char i = 0; i < Frames; i++)
+    {
+        displayRender(drawBlank);
+    }
+    elapsedUs = micros() - startUs;
+    Serial.print(F("Page mode: "));
+#else
+    layerCached = 0;
+    display.clearDisplay();
+    startUs = micros();
+    for (unsigned char i = 0; i < Frames; i++)
+    {
+  #ifdef DISPLAY_LEAN_DRIVER
+        display.markAllDirty();     // Otherwise only the first frame would be sent
+  #endif
+        display.display();
+    }
+    elapsedUs = micros() - startUs;
+
+  #if defined(DISPLAY_LEAN_DRIVER) && defined(SSD1306_TRANSPORT_SPI)
+    Serial.print(F("Lean driver, SPI: "));
+  #elif defined(DISPLAY_LEAN_DRIVER)
+    Serial.print(F("Lean driver, I2C: "));
+  #else
+    Serial.print(F("Adafruit driver, I2C: "));
+  #endif
+#endif
+
+    Serial.print(float(elapsedUs) / 1000.0 / Frames);
+    Serial.print(F(" ms/frame, "));
+    Serial.print(float(SCREEN_WIDTH * SCREEN_HEIGHT / 8) * Frames * 1000000.0 / float(elapsedUs));
+    Serial.println(F(" bytes/s"));
+
+#if defined(DISPLAY2_SERCOM) && DISPLAY2_MIRROR && !defined(DISPLAY_PAGE_MODE)
+    // Both panels, the second one's flush overlapping the main one's
+    startUs = micros();
+    for (unsigned char i = 0; i < Frames; i++)
+    {
+  #ifdef DISPLAY_LEAN_DRIVER
+        display.markAllDirty();
+  #endif
+        mirrorFrame(true);
+        display.display();
+    }
+    display2Wait();
+    elapsedUs = micros() - startUs;
+
+    Serial.print(F("Both panels: "));
+    Serial.print(float(elapsedUs) / 1000.0 / Frames);
+    Serial.print(F(" ms/frame, "));
+    Serial.print(2.0 * Frames * 1000000.0 / float(elapsedUs));
+    Serial.println(F(" panel frames/s"));
+#endif
+}
+
+
+/***********************************************************************************
+ * @brief - displayRender2()
+ *  Draws a frame on the second panel. Does nothing unless the second panel is
+ *    enabled and set to show its own content (DISPLAY2_MIRROR = 0). The frame is
+ *    sent from the SERCOM interrupt, so this returns while it is still going out.
+ * 
+ * @param - Draw: Function that draws the frame
+ * 
+ * @return - None
+ ***********************************************************************************/
+void displayRender2(DISPLAY_DRAW_FN Draw)
+{
+#if defined(DISPLAY2_SERCOM) && !DISPLAY2_MIRROR
+    display2Wait();
+    display2.clearDisplay();
+    Draw(display2);
+    display2Send(0, SCREEN_WIDTH - 1, 0, SSD1306_NUM_PAGES - 1);
+    countFrames(1);
+#else
+    (void)Draw;
+#endif
+}
+
+
+/***********************************************************************************
+ * @brief - displayInvalidate()
+ *  Call after writing to the panel without going through this module, e.g. with
+ *    ssd1306WriteData(). The next frame is then sent in full.
+ *
+ * @return - None
+ ***********************************************************************************/
+void displayInvalidate()
+{
+#ifdef DISPLAY_PAGE_MODE
+    alertOnPanel = false;
+#else
+    layerCached = 0;
+  #ifdef DISPLAY_LEAN_DRIVER
+    display.markAllDirty();
+  #endif
+#endif
+}
+
+/***********************************************************************************
+ * @brief - displayRenderLayered()
+ *  Draws a frame from a cached background and a dynamic layer. The first frame of a
+ *    layout draws the background, caches it and sends the whole screen. After that
+ *    each region is restored from the cache, Dynamic ORs (white) or ANDs out (black)
+ *    its pixels on top, and only regions whose bytes changed are sent, each as its
+ *    own window.
+ *
+ *  Page mode has no room for the cache, so both layers are drawn every frame.
+ *
+ * @param - Layout: Screen to draw
+ *
+ * @return - None
+ ***********************************************************************************/
+void displayRenderLayered(const DISPLAY_LAYOUT * Layout)
+{
+#ifdef DISPLAY_PAGE_MODE
+    layerFull = Layout;
+    displayRender(drawLayoutFull);
+#else
+    if (effectBlocksFrame())
+    {
+        return;
+    }
+
+    if (Layout != layerCached)
+    {
+        layerBuild(Layout);
+        layerSendAll(Layout);
+        frameSent();
+        return;
+    }
+
+    layerRestoreRegions(Layout);
+    Layout->Dynamic(display);
+
+  #ifdef DISPLAY_LEAN_DRIVER
+    display.clearDirty();   // Drawing marked the regions dirty whether they changed or not
+  #endif
+
+    layerQueueRegions(Layout);
+    layerFinish();
+    frameSent();
+#endif
+}
+
+
+/***********************************************************************************
+ * @brief - displayBenchmarkLayered()
+ *  Times a layout drawn with displayRenderLayered() against clearing and redrawing
+ *    both layers every frame, and prints both to the serial port. The dynamic layer
+ *    draws whatever values it currently holds.
+ *
+ * @param - Layout: Screen to draw
+ * @param - Frames: Number of frames to time for each path
+ *
+ * @return - None
+ ***********************************************************************************/
+void displayBenchmarkLayered(const DISPLAY_LAYOUT * Layout, unsigned char Frames)
+{
+    unsigned long startUs, fullUs, layeredUs;
+
+    layerFull = Layout;
+    startUs = micros();
+    for (unsigned char i = 0; i < Frames; i++)
+    {
+        displayRender(drawLayoutFull);
+    }
+    fullUs = micros() - startUs;
+
+    displayRenderLayered(Layout);   // Build the cache outside the timed loop
+    startUs = micros();
+    for (unsigned char i = 0; i < Frames; i++)
+    {
+        displayRenderLayered(Layout);
+    }
+    layeredUs = micros() - startUs;
+
+    Serial.print(F("Clear and redraw: "));
+    Serial.print(fullUs / Frames);
+    Serial.print(F(" us/frame, layered: "));
+    Serial.print(layeredUs / Frames);
+    Serial.println(F(" us/frame"));
+}
+
+
+/***********************************************************************************
+ * @brief - displayRenderDial()
+ *  Draws the dial with its needle at Angle. The first frame draws the face into
+ *    the layered background cache and sends the whole screen. After that the old
+ *    needle is rasterized again and each of its pixels is put back from the cache,
+ *    the readout regions are redrawn, and the new needle is drawn on top. Only the
+ *    columns of each page where the needle changed a pixel are sent, plus any
+ *    readout region whose bytes changed.
+ *
+ *  Page mode has no room for the cache, so the face is drawn every frame.
+ *
+ * @param - Dial: Dial to draw
+ * @param - Angle: Needle angle, see baseDial.hpp
+ *
+ * @return - None
+ ***********************************************************************************/
+void displayRenderDial(const DISPLAY_DIAL * Dial, int16_t Angle)
+{
+#ifdef DISPLAY_PAGE_MODE
+    dialFull = Dial;
+    dialFullAngle = Angle;
+    displayRender(drawDialFull);
+#else
+    unsigned char * frame = display.getBuffer();
+
+    if (effectBlocksFrame())
+    {
+        return;
+    }
+
+    if (&Dial->Layout != layerCached)
+    {
+        layerBuild(&Dial->Layout);
+        dialDrawNeedle(Dial, Angle, plotGfx, &display);
+        layerSendAll(&Dial->Layout);
+        dialShownAngle = Angle;
+        frameSent();
+        return;
+    }
+
+    for (unsigned char page = 0; page < SSD1306_NUM_PAGES; page++)
+    {
+        dialSpanX0[page] = SCREEN_WIDTH;
+        dialSpanX1[page] = -1;
+    }
+
+    if (Angle != dialShownAngle)
+    {
+        dialDrawNeedle(Dial, dialShownAngle, plotErase, frame);
+    }
+
+    // The needle is drawn after the readout, so it is never left behind a region
+    layerRestoreRegions(&Dial->Layout);
+    Dial->Layout.Dynamic(display);
+    dialDrawNeedle(Dial, Angle, plotSet, frame);
+    dialShownAngle = Angle;
+
+  #ifdef DISPLAY_LEAN_DRIVER
+    display.clearDirty();
+  #endif
+
+    layerQueueRegions(&Dial->Layout);
+    for (unsigned char page = 0; page < SSD1306_NUM_PAGES; page++)
+    {
+        if (dialSpanX0[page] <= dialSpanX1[page])
+        {
+            layerQueueWindow(dialSpanX0[page], dialSpanX1[page], page, page);
+        }
+    }
+
+    layerFinish();
+    frameSent();
+#endif
+}
+
+
+/***********************************************************************************
+ * @brief - displayBenchmarkDial()
+ *  Sweeps the needle from Angle0 to Angle1, once clearing and redrawing the whole
+ *    dial every frame and once with displayRenderDial(), and prints both times to
+ *    the serial port.
+ *
+ * @param - Dial: Dial to draw
+ * @param - Angle0: Needle angle before the first frame
+ * @param - Angle1: Needle angle on the last frame
+ * @param - Frames: Number of frames to time for each path
+ *
+ * @return - None
+ ***********************************************************************************/
+void displayBenchmarkDial(const DISPLAY_DIAL * Dial, int16_t Angle0, int16_t Angle1, unsigned char Frames)
+{
+    unsigned long startUs, fullUs, dialUs;
+
+    dialFull = Dial;
+    startUs = micros();
+    for (unsigned char i = 0; i < Frames; i++)
+    {
+        dialFullAngle = Angle0 + (int16_t)((int32_t)(Angle1 - Angle0) * (i + 1) / Frames);
+        displayRender(drawDialFull);
+    }
+    fullUs = micros() - startUs;
+
+    displayRenderDial(Dial, Angle0);    // Build the cache outside the timed loop
+    startUs = micros();
+    for (unsigned char i = 0; i < Frames; i++)
+    {
+        displayRenderDial(Dial, Angle0 + (int16_t)((int32_t)(Angle1 - Angle0) * (i + 1) / Frames));
+    }
+    dialUs = micros() - startUs;
+
+    Serial.print(F("Dial clear and redraw: "));
+    Serial.print(fullUs / Frames);
+    Serial.print(F(" us/frame, incremental: "));
+    Serial.print(dialUs / Frames);
+    Serial.println(F(" us/frame"));
+}
+
+
+/***********************************************************************************
+ * @brief - effectRestore()
+ *  Ends the running effect and undoes what effects left on the panel. After a
+ *    wipe the panel stays off until the next frame is sent.
+ *
+ * @param - WakePanel: Turn the panel back on if an effect left it off
+ *
+ * @return - None
+ ***********************************************************************************/
+static void effectRestore(bool WakePanel)
+{
+    if (effectScrolling())
+    {
+        effectCommand(SSD1306_CMD_SCROLL_OFF);
+        effectPanelOn(false);
+        effectWakePending = true;
+        displayInvalidate();        // Scrolling moved the panel RAM
+    }
+    effect = DISPLAY_EFFECT_NONE;
+
+    if (effectInverted)
+    {
+        effectCommand(SSD1306_CMD_NORMAL);
+        effectInverted = false;
+    }
+    if (effectDimmed)
+    {
+        effectContrast(SSD1306_CONTRAST_NORMAL);
+    }
+    if (WakePanel && effectPanelOff && !effectWakePending)
+    {
+        effectPanelOn(true);
+    }
+}
+
+
+/***********************************************************************************
+ * @brief - displayEffectStop()
+ *  Stops the running effect and puts the panel back to normal: on, not inverted,
+ *    full contrast.
+ *
+ * @return - None
+ ***********************************************************************************/
+void displayEffectStop()
+{
+    effectRestore(true);
+}
+
+
+/***********************************************************************************
+ * @brief - displayEffectStart()
+ *  Starts a command-only effect, replacing any effect already running. Each step
+ *    costs one or two command bytes. Nothing happens until displayEffectsService()
+ *    is called.
+ *
+ * @param - Effect: Effect to run
+ * @param - PeriodMs: Length of one blink or flash, or of the whole fade or wipe
+ * @param - Count: Blinks or flashes to run, 0 = until displayEffectStop(). Ignored
+ *                 for fades and wipes.
+ *
+ * @return - None
+ ***********************************************************************************/
+void displayEffectStart(DISPLAY_EFFECT Effect, unsigned int PeriodMs, unsigned char Count)
+{
+    // A fade-in brings a dark panel up itself, switching it on first would flash
+    effectRestore(Effect != DISPLAY_EFFECT_FADE_IN);
+    if (Effect == DISPLAY_EFFECT_NONE || Effect >= DISPLAY_EFFECT_MAX || PeriodMs == 0)
+    {
+        return;
+    }
+
+    effect = Effect;
+    effectPeriodMs = PeriodMs;
+    effectCount = Count;
+    effectStep = 0;
+    effectStartMs = millis();
+
+    if (Effect == DISPLAY_EFFECT_FADE_IN)
+    {
+        effectContrast(SSD1306_CONTRAST_DIM);
+        effectPanelOn(true);
+    }
+    else if (effectScrolling())
+    {
+        effectCommand(Effect == DISPLAY_EFFECT_WIPE_LEFT ? SSD1306_CMD_SCROLL_LEFT : SSD1306_CMD_SCROLL_RIGHT);
+        effectCommand(0x00);
+        effectCommand(0);                           // Start page
+        effectCommand(SSD1306_SCROLL_2_FRAMES);
+        effectCommand(SSD1306_NUM_PAGES - 1);       // End page
+        effectCommand(0x00);
+        effectCommand(0xFF);
+        effectCommand(SSD1306_CMD_SCROLL_ON);
+    }
+}
+
+
+bool displayEffectActive()
+{
+    return effect != DISPLAY_EFFECT_NONE;
+}
+
+
+/***********************************************************************************
+ * @brief - displayEffectsService()
+ *  Advances the running effect. Call once per loop(). Only sends commands when
+ *    the effect moves to a new step, and catches up if a loop ran long. Also
+ *    sends the mirrored second panel any change it was skipped for while busy.
+ *
+ * @param - NowMs: Current time in ms, normally millis()
+ *
+ * @return - None
+ ***********************************************************************************/
+void displayEffectsService(unsigned long NowMs)
+{
+    unsigned long elapsedMs = NowMs - effectStartMs;
+    unsigned int step;
+
+#ifndef DISPLAY_PAGE_MODE
+    if (!effectBlocksFrame())
+    {
+        mirrorService(false);
+    }
+#endif
+
+    switch (effect)
+    {
+        case DISPLAY_EFFECT_BLINK:
+        case DISPLAY_EFFECT_INVERT_FLASH:
+            // Odd half-periods are the off / inverted half
+            step = elapsedMs / (effectPeriodMs / 2 ? effectPeriodMs / 2 : 1);
+            if (effectCount && step >= 2u * effectCount)
+            {
+                displayEffectStop();
+                return;
+            }
+            if (step == effectStep)
+            {
+                return;
+            }
+            effectStep = step;
+
+            if (effect == DISPLAY_EFFECT_BLINK)
+            {
+                effectPanelOn(!(step & 1));
+            }
+            else
+            {
+                effectInverted = step & 1;
+                effectCommand(effectInverted ? SSD1306_CMD_INVERT : SSD1306_CMD_NORMAL);
+            }
+            break;
+
+        case DISPLAY_EFFECT_FADE_OUT:
+        case DISPLAY_EFFECT_FADE_IN:
+        case DISPLAY_EFFECT_WIPE_LEFT:
+        case DISPLAY_EFFECT_WIPE_RIGHT:
+            step = min(elapsedMs * EFFECT_FADE_STEPS / effectPeriodMs, (unsigned long)EFFECT_FADE_STEPS);
+            if (step == effectStep)
+            {
+                return;
+            }
+            effectStep = step;
+
+            if (effect == DISPLAY_EFFECT_FADE_IN)
+            {
+                effectContrast(SSD1306_CONTRAST_NORMAL * step / EFFECT_FADE_STEPS);
+            }
+            else
+            {
+                effectContrast(SSD1306_CONTRAST_NORMAL * (EFFECT_FADE_STEPS - step) / EFFECT_FADE_STEPS);
+            }
+
+            if (step >= EFFECT_FADE_STEPS)
+            {
+                if (effect == DISPLAY_EFFECT_FADE_OUT)
+                {
+                    effectPanelOn(false);   // Contrast 0 still shows a faint image
+                    effect = DISPLAY_EFFECT_NONE;
+                    effectContrast(SSD1306_CONTRAST_NORMAL);
+                }
+                else
+                {
+                    displayEffectStop();
+                }
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/***********************************************************************************
+ * @brief - displayPrintHappyChibi()
+ *  Just prints happy chibi to the OLED.
+ * 
+ * @return - None
+ ***********************************************************************************/
+void displayPrintHappyChibi()
+{
+    displayRender(drawHappyChibi);
+}
+
+
+/***********************************************************************************
+ * @brief - displayBlinkChibi()
+ *  Blinks happy chibi on the OLED screen on and off every 500 ms. The image is
+ *    sent once and the blinking is done by switching the panel off and on.
+ *    Blocks for the whole time, for a non-blocking blink use
+ *    displayEffectStart(DISPLAY_EFFECT_BLINK, ...).
+ * 
+ * @param - TimeSeconds: Int representing the amount of time to blink for 
+ * 
+ * @return - None
+ ***********************************************************************************/
+void displayBlinkChibi(int TimeSeconds)
+{
+    // Blink screen while waiting so that we can show that
+    // firmware is alive.
+    displayEffectStop();
+    displayPrintHappyChibi();
+    displayEffectStart(DISPLAY_EFFECT_BLINK, BLINK_PERIOD_MS, TimeSeconds);
+    while (displayEffectActive())
+    {
+        displayEffectsService(millis());
+    }
+}
+
+
+/***********************************************************************************
+ * @brief - displayPrintAlert()
+ *  Fills the whole OLED with the over-temperature alert. Drawn inverted so it
+ *    can't be mistaken for the normal gauge. Call every loop, only the values that
+ *    changed are sent. Page mode has no cache to compare against, so there the
+ *    frame is skipped unless a value prints differently.
+ * 
+ * @param - Temp: Temperature to show
+ * @param - SlopePerSec: Current rate of change in F/s
+ * 
+ * @return - None
+ ***********************************************************************************/
+void displayPrintAlert(int Temp, float SlopePerSec)
+{
+    int slopeTenths = (int)(SlopePerSec * 10.0f + (SlopePerSec < 0 ? -0.5f : 0.5f));
+
+  #ifdef DISPLAY_PAGE_MODE
+    if (alertOnPanel && Temp == alertTemp && slopeTenths == alertSlopeTenths)
+    {
+        return;
+    }
+  #endif
+
+    alertTemp = Temp;
+    alertSlopeTenths = slopeTenths;
+    displayRenderLayered(&ALERT_LAYOUT);
+}
+
+
 /***********************************************************************************
  * @brief - displaySerialDebugPrint()
  *  Prints the contents of an image byte array to the serial port
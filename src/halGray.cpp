@@ -0,0 +1,156 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   halGray.cpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Definitions for showing 4-level grayscale images on the 1bpp panel
+*   by temporal dithering
+*
+*/
+
+#include "halGray.hpp"
+#include "halDisplay.hpp"
+
+#if GRAY_SUPPORTED
+/***********************************************************************************
+ * @brief - sendSubframe()
+ *  Combines the two planes for one subframe a page at a time and streams them to
+ *    the panel. No framebuffer is touched, so this works in page mode too.
+ *
+ * @param - Image: Gray image
+ * @param - Subframe: 0 to GRAY_NUM_SUBFRAMES - 1
+ *
+ * @return - None
+ ***********************************************************************************/
+static void sendSubframe(const GRAY_IMAGE * Image, unsigned char Subframe)
+{
+    unsigned char page[SSD1306_PAGE_BYTES];
+    unsigned int idx = 0;
+
+    ssd1306SetWindow(0, SSD1306_WIDTH - 1, 0, SSD1306_NUM_PAGES - 1);
+
+    for (unsigned char p = 0; p < SSD1306_NUM_PAGES; p++)
+    {
+        for (unsigned char c = 0; c < SSD1306_PAGE_BYTES; c++, idx++)
+        {
+            unsigned char high = pgm_read_byte(&Image->High[idx]);
+            unsigned char low = pgm_read_byte(&Image->Low[idx]);
+
+            switch (Subframe)
+            {
+                case 0:  page[c] = high | low; break;
+                case 1:  page[c] = high;       break;
+                default: page[c] = high & low; break;
+            }
+        }
+        ssd1306WriteData(page, SSD1306_PAGE_BYTES);
+    }
+}
+#endif
+
+
+/***********************************************************************************
+ * @brief - grayShow()
+ *  Shows a gray image for a while, blocking. The first GRAY_CALIBRATE_SUBFRAMES
+ *    subframes are sent back to back to find how long one takes. The rest are
+ *    started on a fixed period just above that, so every subframe is on screen for
+ *    the same time and the gray levels stay even. A late subframe restarts the
+ *    schedule instead of bunching the following ones up.
+ *
+ *  The panel's own scan is sped up for the duration, which shortens the time a
+ *    half-written frame is visible. It is restored before returning. The caller
+ *    has to redraw the screen afterwards.
+ *
+ * @param - Image: Gray image
+ * @param - DurationMs: How long to show it
+ * @param - Stats: Receives the measured timing, may be 0
+ *
+ * @return - GRAY_STATUS: GRAY_STATUS_UNSUPPORTED without the in-tree driver
+ ***********************************************************************************/
+GRAY_STATUS grayShow(const GRAY_IMAGE * Image, unsigned long DurationMs, PTR_GRAY_STATS Stats)
+{
+#if GRAY_SUPPORTED
+    unsigned long startMs = millis();
+    unsigned long periodUs = 0, worstUs = 0;
+    unsigned long nextUs = 0, lastStartUs = 0, pacedStartUs = 0;
+    unsigned long minUs = 0xFFFFFFFF, maxUs = 0;
+    unsigned long paced = 0;
+    unsigned int late = 0;
+
+    if (Image == 0 || Image->High == 0 || Image->Low == 0)
+    {
+        return GRAY_STATUS_INVALID_PARAM;
+    }
+
+    ssd1306Command(SSD1306_CMD_SET_CLOCK_DIV);
+    ssd1306Command(SSD1306_CLOCK_DIV_FASTEST);
+
+    for (unsigned long n = 0; millis() - startMs < DurationMs; n++)
+    {
+        unsigned long startUs;
+
+        if (n >= GRAY_CALIBRATE_SUBFRAMES)
+        {
+            while ((long)(micros() - nextUs) < 0)
+            {
+            }
+        }
+
+        startUs = micros();
+        if (n > GRAY_CALIBRATE_SUBFRAMES)
+        {
+            unsigned long intervalUs = startUs - lastStartUs;
+            minUs = min(minUs, intervalUs);
+            maxUs = max(maxUs, intervalUs);
+            paced++;
+        }
+        else if (n == GRAY_CALIBRATE_SUBFRAMES)
+        {
+            pacedStartUs = startUs;
+        }
+        lastStartUs = startUs;
+
+        sendSubframe(Image, n % GRAY_NUM_SUBFRAMES);
+
+        if (n < GRAY_CALIBRATE_SUBFRAMES)
+        {
+            worstUs = max(worstUs, micros() - startUs);
+            periodUs = worstUs + (worstUs >> GRAY_PERIOD_MARGIN_SHIFT);
+            nextUs = micros();
+        }
+        else
+        {
+            nextUs = startUs + periodUs;
+            if ((long)(micros() - nextUs) > 0)
+            {
+                late++;
+                nextUs = micros();
+            }
+        }
+    }
+
+    ssd1306Command(SSD1306_CMD_SET_CLOCK_DIV);
+    ssd1306Command(SSD1306_CLOCK_DIV_DEFAULT);
+    displayInvalidate();
+
+    if (Stats)
+    {
+        unsigned long pacedUs = lastStartUs - pacedStartUs;
+
+        Stats->Fps = (paced && pacedUs) ? float(paced) * 1000000.0 / float(pacedUs) : 0;
+        Stats->CycleHz = Stats->Fps / GRAY_NUM_SUBFRAMES;
+        Stats->PeriodUs = periodUs;
+        Stats->MinPeriodUs = paced ? minUs : 0;
+        Stats->MaxPeriodUs = maxUs;
+        Stats->JitterPct = (paced && periodUs) ? float(maxUs - minUs) * 100.0 / float(periodUs) : 0;
+        Stats->LateFrames = late;
+    }
+
+    return GRAY_STATUS_SUCCESS;
+#else
+    (void)Image;
+    (void)DurationMs;
+    (void)Stats;
+    return GRAY_STATUS_UNSUPPORTED;
+#endif
+}
@@ -0,0 +1,28 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   halSram.cpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Definitions for checking the free SRAM on AVR
+*
+*/
+
+#include "halSram.hpp"
+#include <Arduino.h>
+
+#ifdef __AVR__
+/***********************************************************************************
+ * @brief - sramGetFree()
+ *  Measures the SRAM left between the top of the heap and the caller's stack
+ *    frame. Anything the caller then pushes comes out of this.
+ *
+ * @return - Free bytes
+ ***********************************************************************************/
+unsigned int sramGetFree()
+{
+  extern int __heap_start, *__brkval;
+  int top;
+
+  return (uintptr_t)&top - (uintptr_t)(__brkval == 0 ? &__heap_start : __brkval);
+}
+#endif
@@ -0,0 +1,421 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   halSsd1306.cpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Definitions for the in-tree SSD1306 driver
+*
+*/
+
+#include "halSsd1306.hpp"
+
+#ifdef SSD1306_TRANSPORT_SPI
+#include <SPI.h>
+#else
+#include <Wire.h>
+#endif
+
+// Data bytes per I2C transaction. One byte of the Wire buffer is used by the control byte.
+#ifdef __AVR__
+#define I2C_CHUNK_LEN       (BUFFER_LENGTH - 1)
+#else
+#define I2C_CHUNK_LEN       63
+#endif
+
+
+// Same power-on sequence as the Adafruit driver uses for a 128x64 panel. The charge pump
+// and pre-charge settings depend on the supply and are sent by ssd1306Init() after it.
+const unsigned char SSD1306_INIT_SEQ[] PROGMEM =
+  {
+    SSD1306_CMD_DISPLAY_OFF,
+    SSD1306_CMD_SET_CLOCK_DIV, SSD1306_CLOCK_DIV_DEFAULT,
+    0xA8, 0x3F,         // Multiplex ratio = 64 rows
+    0xD3, 0x00,         // No display offset
+    0x40,               // Start line 0
+    0x20, 0x00,         // Horizontal addressing mode
+    0xA1,               // Segment remap, column 127 -> SEG0
+    0xC8,               // COM scan direction remapped
+    0xDA, 0x12,         // COM pin configuration
+    SSD1306_CMD_SET_CONTRAST, SSD1306_CONTRAST_NORMAL,
+    0xDB, 0x40,         // VCOMH deselect level
+    0xA4,               // Display follows RAM
+    SSD1306_CMD_NORMAL,
+    SSD1306_CMD_SCROLL_OFF
+  };
+
+
+/***********************************************************************************
+ * Transport
+ *  transportBegin(), transportCommands() and transportData() are the only
+ *    functions that touch the bus. Exactly one implementation is compiled in.
+ ***********************************************************************************/
+#ifdef SSD1306_TRANSPORT_SPI
+
+// Addr is only used on I2C, the SPI panel is selected by its CS pin
+static void transportBegin(unsigned char Addr)
+{
+    (void)Addr;
+
+    pinMode(SSD1306_SPI_CS_PIN, OUTPUT);
+    pinMode(SSD1306_SPI_DC_PIN, OUTPUT);
+    pinMode(SSD1306_SPI_RST_PIN, OUTPUT);
+    digitalWrite(SSD1306_SPI_CS_PIN, HIGH);
+
+    SPI.begin();
+
+    // Hardware reset pulse, the SPI panels don't reset themselves reliably
+    digitalWrite(SSD1306_SPI_RST_PIN, HIGH);
+    delay(1);
+    digitalWrite(SSD1306_SPI_RST_PIN, LOW);
+    delay(10);
+    digitalWrite(SSD1306_SPI_RST_PIN, HIGH);
+    delayMicroseconds(10);     // Panel needs a few us out of reset before the first command
+}
+
+// DC low = command bytes, DC high = display RAM bytes
+static void transportSend(bool IsData, const unsigned char * Bytes, unsigned int Len)
+{
+    SPI.beginTransaction(SPISettings(SSD1306_SPI_CLOCK_HZ, MSBFIRST, SPI_MODE0));
+    digitalWrite(SSD1306_SPI_DC_PIN, IsData ? HIGH : LOW);
+    digitalWrite(SSD1306_SPI_CS_PIN, LOW);
+
+    // Byte at a time, the buffer overload of transfer() overwrites its input
+    for (unsigned int i = 0; i < Len; i++)
+    {
+        SPI.transfer(Bytes[i]);
+    }
+
+    digitalWrite(SSD1306_SPI_CS_PIN, HIGH);
+    SPI.endTransaction();
+}
+
+static void transportCommands(const unsigned char * Cmds, unsigned int Len)
+{
+    transportSend(false, Cmds, Len);
+}
+
+static void transportData(const unsigned char * Data, unsigned int Len)
+{
+    transportSend(true, Data, Len);
+}
+
+#else
+
+static unsigned char transportAddr = SSD1306_I2C_ADDR;
+
+static void transportBegin(unsigned char Addr)
+{
+    transportAddr = Addr;
+    Wire.begin();
+    Wire.setClock(SSD1306_I2C_CLOCK_HZ);
+}
+
+// Commands are short, a single transaction always fits the Wire buffer
+static void transportCommands(const unsigned char * Cmds, unsigned int Len)
+{
+    Wire.beginTransmission(transportAddr);
+    Wire.write((uint8_t)SSD1306_CTRL_COMMAND);
+    Wire.write(Cmds, Len);
+    Wire.endTransmission();
+}
+
+static void transportData(const unsigned char * Data, unsigned int Len)
+{
+    while (Len > 0)
+    {
+        unsigned int chunk = (Len > I2C_CHUNK_LEN) ? I2C_CHUNK_LEN : Len;
+
+        Wire.beginTransmission(transportAddr);
+        Wire.write((uint8_t)SSD1306_CTRL_DATA);
+        Wire.write(Data, chunk);
+        Wire.endTransmission();
+
+        Data += chunk;
+        Len -= chunk;
+    }
+}
+
+#endif
+
+
+/***************************************************************************************
+ * @brief - ssd1306Init()
+ *  Starts the bus and sends the power-on command sequence, then turns the panel on.
+ *
+ * @param - VccState: SSD1306_SWITCHCAPVCC to run the internal charge pump,
+ *                    SSD1306_EXTERNALVCC for a panel with its own supply
+ * @param - Addr: 7-bit I2C address of the panel, unused on SPI
+ *
+ * @return - None
+ ***************************************************************************************/
+void ssd1306Init(unsigned char VccState, unsigned char Addr)
+{
+    bool chargePump = (VccState != SSD1306_EXTERNALVCC);
+
+    transportBegin(Addr);
+
+    for (unsigned int i = 0; i < sizeof(SSD1306_INIT_SEQ); i++)
+    {
+        ssd1306Command(pgm_read_byte(&SSD1306_INIT_SEQ[i]));
+    }
+
+    ssd1306Command(0x8D);                           // Charge pump
+    ssd1306Command(chargePump ? 0x14 : 0x10);
+    ssd1306Command(0xD9);                           // Pre-charge period
+    ssd1306Command(chargePump ? 0xF1 : 0x22);
+    ssd1306Command(SSD1306_CMD_DISPLAY_ON);
+}
+
+
+/***********************************************************************************
+ * @brief - ssd1306Command()
+ *  Sends a single command byte.
+ *
+ * @return - None
+ ***********************************************************************************/
+void ssd1306Command(unsigned char Cmd)
+{
+    transportCommands(&Cmd, 1);
+}
+
+
+/***********************************************************************************
+ * @brief - ssd1306SetWindow()
+ *  Sets the column and page range that following data bytes are written to.
+ *    The panel wraps to the next page at Col1 and back to Page0 after Page1.
+ *
+ * @return - None
+ ***********************************************************************************/
+void ssd1306SetWindow(unsigned char Col0, unsigned char Col1, unsigned char Page0, unsigned char Page1)
+{
+    unsigned char cmds[] =
+      {
+        SSD1306_CMD_SET_COL_ADDR, Col0, Col1,
+        SSD1306_CMD_SET_PAGE_ADDR, Page0, Page1
+      };
+
+    transportCommands(cmds, sizeof(cmds));
+}
+
+
+/***********************************************************************************
+ * @brief - ssd1306WriteData()
+ *  Streams display RAM bytes into the current window.
+ *
+ * @param - Data: Bytes to send, one column of one page per byte
+ * @param - Len: Number of bytes
+ *
+ * @return - None
+ ***********************************************************************************/
+void ssd1306WriteData(const unsigned char * Data, unsigned int Len)
+{
+    transportData(Data, Len);
+}
+
+
+#ifdef DISPLAY_LEAN_DRIVER
+/***********************************************************************************
+ * LeanSSD1306
+ *  Only compiled with DISPLAY_LEAN_DRIVER. The page mode and Adafruit builds use
+ *    the raw transfers above and must not carry the 1 KB framebuffer.
+ ***********************************************************************************/
+
+// Static so begin() has nothing to allocate and the linker map shows the real RAM cost
+static unsigned char leanFrameBuffer[SSD1306_BUFFER_BYTES];
+
+LeanSSD1306::LeanSSD1306() : Adafruit_GFX(SSD1306_WIDTH, SSD1306_HEIGHT)
+{
+    markAllDirty();
+}
+
+/***********************************************************************************
+ * @brief - begin()
+ *  Initializes the panel. Takes the same supply and address arguments as
+ *    Adafruit_SSD1306::begin(), see ssd1306Init().
+ *
+ * @return - bool: Always true, there is no allocation to fail
+ ***********************************************************************************/
+bool LeanSSD1306::begin(uint8_t VccState, uint8_t Addr)
+{
+    ssd1306Init(VccState, Addr);
+    clearDisplay();
+    return true;
+}
+
+/***********************************************************************************
+ * @brief - display()
+ *  Sends the dirty window to the panel. When the dirty columns span the full width
+ *    the pages are contiguous in the buffer and go out as one transfer.
+ *
+ * @return - None
+ ***********************************************************************************/
+void LeanSSD1306::display()
+{
+    if (dirtyX0 > dirtyX1)
+    {
+        return;
+    }
+
+    ssd1306SetWindow(dirtyX0, dirtyX1, dirtyPage0, dirtyPage1);
+
+    if (dirtyX0 == 0 && dirtyX1 == SSD1306_WIDTH - 1)
+    {
+        ssd1306WriteData(&leanFrameBuffer[dirtyPage0 * SSD1306_PAGE_BYTES],
+                         (dirtyPage1 - dirtyPage0 + 1) * SSD1306_PAGE_BYTES);
+    }
+    else
+    {
+        for (unsigned char page = dirtyPage0; page <= dirtyPage1; page++)
+        {
+            ssd1306WriteData(&leanFrameBuffer[page * SSD1306_PAGE_BYTES + dirtyX0],
+                             dirtyX1 - dirtyX0 + 1);
+        }
+    }
+
+    dirtyX0 = SSD1306_WIDTH;
+    dirtyX1 = -1;
+}
+
+void LeanSSD1306::clearDisplay()
+{
+    memset(leanFrameBuffer, 0, sizeof(leanFrameBuffer));
+    markAllDirty();
+}
+
+unsigned char * LeanSSD1306::getBuffer()
+{
+    return leanFrameBuffer;
+}
+
+void LeanSSD1306::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+    if (x < 0 || x >= SSD1306_WIDTH || y < 0 || y >= SSD1306_HEIGHT)
+    {
+        return;
+    }
+
+    unsigned char * byte = &leanFrameBuffer[(y >> 3) * SSD1306_PAGE_BYTES + x];
+    unsigned char bit = 1 << (y & 7);
+    switch (color)
+    {
+        case SSD1306_WHITE:   *byte |= bit;  break;
+        case SSD1306_BLACK:   *byte &= ~bit; break;
+        case SSD1306_INVERSE: *byte ^= bit;  break;
+    }
+
+    markDirty(x, y, x, y);
+}
+
+/***********************************************************************************
+ * @brief - fillRect()
+ *  Fills a rectangle a page at a time with byte masks. Text, clears and lines all
+ *    end up here, which avoids one virtual drawPixel() call per pixel.
+ *
+ * @return - None
+ ***********************************************************************************/
+void LeanSSD1306::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+    int16_t x0 = (x > 0) ? x : 0;
+    int16_t y0 = (y > 0) ? y : 0;
+    int16_t x1 = (x + w < SSD1306_WIDTH) ? x + w : SSD1306_WIDTH;       // Exclusive
+    int16_t y1 = (y + h < SSD1306_HEIGHT) ? y + h : SSD1306_HEIGHT;     // Exclusive
+
+    if (x0 >= x1 || y0 >= y1)
+    {
+        return;
+    }
+
+    for (int16_t page = y0 >> 3; page <= (y1 - 1) >> 3; page++)
+    {
+        int16_t rowStart = (y0 > page * 8) ? y0 - page * 8 : 0;
+        int16_t rowEnd = (y1 < page * 8 + 8) ? y1 - page * 8 : 8;
+        unsigned char mask = (unsigned char)(((1 << (rowEnd - rowStart)) - 1) << rowStart);
+        unsigned char * byte = &leanFrameBuffer[page * SSD1306_PAGE_BYTES + x0];
+
+        for (int16_t i = x0; i < x1; i++, byte++)
+        {
+            switch (color)
+            {
+                case SSD1306_WHITE:   *byte |= mask;  break;
+                case SSD1306_BLACK:   *byte &= ~mask; break;
+                case SSD1306_INVERSE: *byte ^= mask;  break;
+            }
+        }
+    }
+
+    markDirty(x0, y0, x1 - 1, y1 - 1);
+}
+
+void LeanSSD1306::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+    fillRect(x, y, w, 1, color);
+}
+
+void LeanSSD1306::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+    fillRect(x, y, 1, h, color);
+}
+
+void LeanSSD1306::fillScreen(uint16_t color)
+{
+    fillRect(0, 0, SSD1306_WIDTH, SSD1306_HEIGHT, color);
+}
+
+/***********************************************************************************
+ * @brief - markDirty()
+ *  Grows the window sent by the next display() to include a rectangle. Callers
+ *    that write into getBuffer() directly must call this themselves.
+ *
+ * @return - None
+ ***********************************************************************************/
+void LeanSSD1306::markDirty(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    unsigned char page0 = y0 >> 3;
+    unsigned char page1 = y1 >> 3;
+
+    if (dirtyX0 > dirtyX1)
+    {
+        dirtyX0 = x0;
+        dirtyX1 = x1;
+        dirtyPage0 = page0;
+        dirtyPage1 = page1;
+        return;
+    }
+
+    if (x0 < dirtyX0) dirtyX0 = x0;
+    if (x1 > dirtyX1) dirtyX1 = x1;
+    if (page0 < dirtyPage0) dirtyPage0 = page0;
+    if (page1 > dirtyPage1) dirtyPage1 = page1;
+}
+
+void LeanSSD1306::markAllDirty()
+{
+    dirtyX0 = 0;
+    dirtyX1 = SSD1306_WIDTH - 1;
+    dirtyPage0 = 0;
+    dirtyPage1 = SSD1306_NUM_PAGES - 1;
+}
+
+// Forgets pending changes, for callers that know the panel already shows them
+void LeanSSD1306::clearDirty()
+{
+    dirtyX0 = SSD1306_WIDTH;
+    dirtyX1 = -1;
+}
+
+void LeanSSD1306::invertDisplay(bool i)
+{
+    ssd1306Command(i ? SSD1306_CMD_INVERT : SSD1306_CMD_NORMAL);
+}
+
+void LeanSSD1306::dim(bool dim)
+{
+    unsigned char cmds[] = { SSD1306_CMD_SET_CONTRAST, (unsigned char)(dim ? SSD1306_CONTRAST_DIM : SSD1306_CONTRAST_NORMAL) };
+    transportCommands(cmds, sizeof(cmds));
+}
+
+void LeanSSD1306::ssd1306_command(uint8_t c)
+{
+    ssd1306Command(c);
+}
+#endif
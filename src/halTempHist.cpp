@@ -0,0 +1,171 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   halTempHist.cpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Definitions for saving the time-at-temperature histogram across
+*   power cycles and dumping it over serial
+*
+*/
+
+#include <Arduino.h>
+#include "halTempHist.hpp"
+#include "halCapture.hpp"
+
+#ifdef __AVR__
+  #include <EEPROM.h>
+#else
+  #include <FlashStorage.h>
+  // Each instance is aligned to its own flash row, so erasing one leaves the other intact
+  FlashStorage(tempHistFlash0, TEMPHIST_SLOT);
+  FlashStorage(tempHistFlash1, TEMPHIST_SLOT);
+#endif
+
+// Saves counted from power-up, before settling on TEMPHIST_SAVE_INTERVAL_MS
+#ifdef __AVR__
+  const unsigned long TEMPHIST_EARLY_SAVE_MS[] = { 1UL * 60 * 1000 };
+#else
+  const unsigned long TEMPHIST_EARLY_SAVE_MS[] = { 2UL * 60 * 1000, 10UL * 60 * 1000 };
+#endif
+#define NUM_EARLY_SAVES     (sizeof(TEMPHIST_EARLY_SAVE_MS) / sizeof(TEMPHIST_EARLY_SAVE_MS[0]))
+
+unsigned long tempHistBootMs = 0;
+unsigned long tempHistLastSaveMs = 0;
+unsigned char tempHistEarlyIt = 0;      // Next early save
+uint32_t tempHistSavedTotal = 0;        // Total seconds in the last saved record
+uint32_t tempHistSeq = 0;               // Sequence number of the last save
+unsigned char tempHistNextSlot = 0;     // Slot the next save goes to
+
+
+static void slotRead(unsigned char Slot, PTR_TEMPHIST_SLOT Data)
+{
+#ifdef __AVR__
+  EEPROM.get(TEMPHIST_EEPROM_ADDR + Slot * sizeof(TEMPHIST_SLOT), *Data);
+#else
+  *Data = (Slot == 0) ? tempHistFlash0.read() : tempHistFlash1.read();
+#endif
+}
+
+
+static void slotWrite(unsigned char Slot, const TEMPHIST_SLOT * Data)
+{
+#ifdef __AVR__
+  EEPROM.put(TEMPHIST_EEPROM_ADDR + Slot * sizeof(TEMPHIST_SLOT), *Data);
+#else
+  if (Slot == 0)
+  {
+    tempHistFlash0.write(*Data);
+  }
+  else
+  {
+    tempHistFlash1.write(*Data);
+  }
+#endif
+}
+
+
+/***************************************************************************************
+ * Loads the newest saved histogram whose record checks out, falling back to the other
+ * slot, or starts empty if neither holds one. The next save goes to the slot that was
+ * not loaded, so the loaded one is kept until that save has completed.
+ ***************************************************************************************/
+void tempHistStoreInit()
+{
+  TEMPHIST_SLOT saved[TEMPHIST_NUM_SLOTS];
+  unsigned char newest;
+
+  tempHistInit();
+
+  slotRead(0, &saved[0]);
+  slotRead(1, &saved[1]);
+
+  // Wrap-safe, a blank slot loses on its record check whatever its sequence number
+  newest = ((int32_t)(saved[1].Seq - saved[0].Seq) > 0) ? 1 : 0;
+
+  tempHistSeq = 0;
+  tempHistNextSlot = 0;
+  for (unsigned char i = 0; i < TEMPHIST_NUM_SLOTS; i++)
+  {
+    unsigned char slot = newest ^ i;
+
+    if (tempHistRestore(&saved[slot].Record) == TEMPHIST_STATUS_SUCCESS)
+    {
+      tempHistSeq = saved[slot].Seq;
+      tempHistNextSlot = slot ^ 1;
+      break;
+    }
+  }
+
+  tempHistSavedTotal = tempHistGetTotalSeconds();
+  tempHistBootMs = millis();
+  tempHistLastSaveMs = tempHistBootMs;
+  tempHistEarlyIt = 0;
+}
+
+
+/***********************************************************************************
+ * @brief - tempHistStoreSave()
+ *  Writes the histogram to the older of the two storage slots. Takes a few ms on
+ *    SAMD21 while the flash row is erased, so only call it from the slow path.
+ *
+ * @return - None
+ ***********************************************************************************/
+void tempHistStoreSave()
+{
+  TEMPHIST_SLOT slot;
+
+  slot.Record = *tempHistSeal();
+  slot.Seq = tempHistSeq + 1;
+  slotWrite(tempHistNextSlot, &slot);
+
+  tempHistSeq = slot.Seq;
+  tempHistNextSlot ^= 1;
+  tempHistSavedTotal = tempHistGetTotalSeconds();
+}
+
+
+/***********************************************************************************
+ * @brief - tempHistStoreService()
+ *  Saves the histogram at each of TEMPHIST_EARLY_SAVE_MS after power-up, then
+ *    once every TEMPHIST_SAVE_INTERVAL_MS, and only if it has changed. Without
+ *    the early saves a drive shorter than the interval was never kept. Call from
+ *    loop(), not from the sampling path.
+ *
+ * @param - NowMs: Current time in ms, normally millis()
+ *
+ * @return - None
+ ***********************************************************************************/
+void tempHistStoreService(unsigned long NowMs)
+{
+  if (tempHistEarlyIt < NUM_EARLY_SAVES)
+  {
+    if (NowMs - tempHistBootMs < TEMPHIST_EARLY_SAVE_MS[tempHistEarlyIt])
+    {
+      return;
+    }
+    tempHistEarlyIt++;
+  }
+  else if (NowMs - tempHistLastSaveMs < TEMPHIST_SAVE_INTERVAL_MS)
+  {
+    return;
+  }
+  tempHistLastSaveMs = NowMs;
+
+  if (tempHistGetTotalSeconds() != tempHistSavedTotal)
+  {
+    tempHistStoreSave();
+  }
+}
+
+
+/***********************************************************************************
+ * @brief - tempHistDump()
+ *  Sends the histogram as a CAPTURE_TYPE_TEMP_HIST record. Read it with
+ *    tools/tempHistDump.py.
+ *
+ * @return - None
+ ***********************************************************************************/
+void tempHistDump()
+{
+  captureWriteRecord(CAPTURE_TYPE_TEMP_HIST, (const unsigned char *)tempHistSeal(), sizeof(TEMPHIST_RECORD));
+}
@@ -8,76 +8,74 @@
 */
 
 #include "halThermistor.hpp"
+#include "baseHistory.hpp"
+#include "baseTrend.hpp"
+#include "halSram.hpp"
+#include "halTempHist.hpp"
 #include <Arduino.h>
 
-// Resistance values that have been experimentally colelcted at specified temperatures.
-// True values have been scaled down by a factor of RES_SCALE_FACTOR.
-// Muliply values in this array by RES_SCALE_FACTOR to get the real resistance.
+#define ADC_RES             float(1UL << GaugeConfig::AdcBits)
 
-#ifdef __AVR__
-#define ADC_RES_NUM_BITS    10
-#else
-#define ADC_RES_NUM_BITS    12
-#endif
+// Resistance average, only kept when GaugeConfig::DataCollection is on
+template <bool Enabled>
+struct RES_AVERAGE
+{
+  float Samples[GaugeConfig::NumSamples];   // Stores the last NumSamples resistance samples
+  int It;                                   // Iterator used to move through Samples
+  double Sum;                               // Current sum of all values in Samples
+};
+
+template <>
+struct RES_AVERAGE<false>
+{
+};
 
-#define ADC_RES             float(1 << ADC_RES_NUM_BITS)
+FIXED_BOXCAR_FILTER<GaugeConfig::NumSamples> tempFilter;    // Rolling average of the last NumSamples temperatures
+RES_AVERAGE<GaugeConfig::DataCollection> resAverage;
 
-#define SERIES_RESISTOR     150.0   // 150 Ohm series resistor is used in voltage divider circuit
-#define RES_SCALE_FACTOR    1       // Factor that RESISTANCE_VALS values are scaled down by
 
-// Slightly altered resistance values based on table in
-// Amazon listing: https://www.amazon.com/PQY-Temperature-Sensor-Sender-Electric/dp/B08MTJJTFK/ref=sr_1_5?crid=OERZDIYZEP9L&dib=eyJ2IjoiMSJ9.Ax70sMO3h5wLucVKUUK2Bwrb6nxw-Lu6bLvDJpekDGBI4DigFONbrwXPxV-sgw89X6lzM9883L_3LrC8yWnMoEvriPWv3NNzZ4iyQO-4LNvSLSnKYAsUfNtXQv3_lTDQFCRILeHsCVX_bl78Ms5qUjWPhXeWWkkRMH-TlVPSYIoXB5e7FeHGZ1fF0KqCmZFNPYI2JyvKXpjqIFwoegBKk649bYwI64wWf6Y5QYecLKk.b8o_X-dBp_B8-4zhSeJtW5AX77OmJs_QCWHkZqiLxsc&dib_tag=se&keywords=thermistor+1%2F8+npt&qid=1754964195&sprefix=thermistor+1%2F8+npt%2Caps%2C155&sr=8-5
-const unsigned int RESISTANCE_VALS[] =
-  {
-    3200,  //    | 68f
-    2150,  //    | 86f
-    1420,  //    | 104f 
-    895,   //    | 122f *
-    620,   //    | 140f *
-    428,   //    | 158f *
-    304,   //    | 176f *
-    224,   //    | 194f *
-    160,   //    | 212f *
-    124,   //    | 230f *
-    95,    //    | 248f *
-    73,    //    | 266f *
-    59,    //    | 284f *
-    45,    //    | 302f *
-    37,    //    | 320f *  
-    30    //     | 338f *
-  };
-
-// Farenheit temperatures based on datasheet in
-// Amazon listing for thermistor: 
-// https://www.amazon.com/PQY-Temperature-Sensor-Sender-Electric/dp/B08MTJJTFK/ref=sr_1_5?crid=OERZDIYZEP9L&dib=eyJ2IjoiMSJ9.Ax70sMO3h5wLucVKUUK2Bwrb6nxw-Lu6bLvDJpekDGBI4DigFONbrwXPxV-sgw89X6lzM9883L_3LrC8yWnMoEvriPWv3NNzZ4iyQO-4LNvSLSnKYAsUfNtXQv3_lTDQFCRILeHsCVX_bl78Ms5qUjWPhXeWWkkRMH-TlVPSYIoXB5e7FeHGZ1fF0KqCmZFNPYI2JyvKXpjqIFwoegBKk649bYwI64wWf6Y5QYecLKk.b8o_X-dBp_B8-4zhSeJtW5AX77OmJs_QCWHkZqiLxsc&dib_tag=se&keywords=thermistor+1%2F8+npt&qid=1754964195&sprefix=thermistor+1%2F8+npt%2Caps%2C155&sr=8-5
-const unsigned int TEMP_VALS[] =
+/***********************************************************************************
+ * Resistance average. The FEATURE_OFF overloads leave getResAvg() returning the
+ * latest reading. These are templates so the storage is only touched, and the
+ * code only built, for the configuration that uses it.
+ ***********************************************************************************/
+template <class AVERAGE>
+static void resAverageInit(AVERAGE & Avg, float Res, FEATURE_ON)
+{
+  Avg.It = 0;
+  Avg.Sum = 0;
+  for (unsigned int i = 0; i < GaugeConfig::NumSamples; i++)
   {
-    68,
-    86,
-    104,
-    122,
-    140,
-    158,
-    176,
-    194,
-    212,
-    230,
-    248, 
-    266,
-    284,
-    302,
-    320,
-    338
-  };
-
-unsigned int tempSamples[NUM_SAMPLES];      // Stores the last NUM_SAMPLES temperature samples
-float resSamples[NUM_SAMPLES];              // Stores the last NUM_SAMPLES resistances samples
-
-int tempIt = 0;                             // Iterator used to move through tempSamples arr
-int resIt = 0;                              // Iterator used ot move through the resSamples arr
-
-unsigned int currTempSum = 0;               // Current sum of all values in tempSamples arr
-double currResSum = 0;                      // Current sum of all values in resSamples arr
+    // Populate entire
+    Avg.Samples[i] = Res;
+    Avg.Sum += Res;
+  }
+}
+
+template <class AVERAGE>
+static void resAverageInit(AVERAGE &, float, FEATURE_OFF)
+{
+}
+
+template <class AVERAGE>
+static float resAveragePush(AVERAGE & Avg, float Res, FEATURE_ON)
+{
+  Avg.It = Avg.It % GaugeConfig::NumSamples;
+
+  Avg.Sum -= Avg.Samples[Avg.It];
+  Avg.Samples[Avg.It] = Res;       // store new sample
+  Avg.Sum += Res;
+
+  Avg.It++;
+
+  return Avg.Sum / GaugeConfig::NumSamples;
+}
+
+template <class AVERAGE>
+static float resAveragePush(AVERAGE &, float Res, FEATURE_OFF)
+{
+  return Res;
+}
 
 
 /***************************************************************************************
@@ -87,20 +85,16 @@ double currResSum = 0;                      // Current sum of all values in resS
 void thermistorMonInit()
 {
     #ifndef __AVR__
-    analogReadResolution(ADC_RES_NUM_BITS);
+    analogReadResolution(GaugeConfig::AdcBits);
     #endif
 
-    float temp = getTemp(false);
-    float res = getRes();
-    for (int i = 0; i < NUM_SAMPLES; i++)
-    {
-        // Populate entire
-        tempSamples[i] = temp;
-        currTempSum += temp;
+    historyInit();
+    trendInit();
+    tempHistStoreInit();
+    spectrumInit();
 
-        resSamples[i] = res;
-        currResSum += res;
-    }
+    boxcarInit(&tempFilter, getTemp(false));
+    resAverageInit(resAverage, getRes(), FeatureTag<GaugeConfig::DataCollection>());
 }
 
 
@@ -108,21 +102,13 @@ void thermistorMonInit()
  * @brief - getResAvg()
  *  Stores a new resistance value in the array of stored samples. Discards the oldest
  *    resistance value. Gets the current average resistance based on the stored samples.
+ *    Without GaugeConfig::DataCollection nothing is stored and the new value is returned.
  * 
  * @return - float: The current average resistance based on the stored samples.
  ***********************************************************************************/
 float getResAvg()
 {
-  float newRes = getRes();
-  resIt = resIt % NUM_SAMPLES;
-
-  currResSum -= resSamples[resIt];
-  resSamples[resIt] = newRes;       // store new sample
-  currResSum += newRes;
-
-  resIt++;
-
-  return currResSum / NUM_SAMPLES;
+  return resAveragePush(resAverage, getRes(), FeatureTag<GaugeConfig::DataCollection>());
 }
 
 
@@ -136,14 +122,14 @@ float getResAvg()
 int getTempAvg()
 {
   int newTemp = getTemp(true);
-  tempIt = tempIt % NUM_SAMPLES;
-  
-  currTempSum -= tempSamples[tempIt];
-  tempSamples[tempIt] = newTemp;        // store new sample
-  currTempSum += newTemp;
-  
-  tempIt++;
-  return currTempSum / NUM_SAMPLES;
+
+  historyAddSample(newTemp, millis());
+  trendAddSample(newTemp, millis());
+
+  int avg = boxcarPush(&tempFilter, newTemp);
+  tempHistAddSample(avg, millis());
+
+  return avg;
 }
 
 
@@ -170,14 +156,9 @@ float getPinVoltage(unsigned char Pin)
  ***********************************************************************************/
 float getRes()
 {
-  float refV, voltage, resistance;
-  voltage = getPinVoltage(SENSOR_PIN);
-  refV = readVcc();
-  //resistance = SERIES_RESISTOR * (refV / voltage - 1.0);
-
-  resistance = (voltage * SERIES_RESISTOR) / (refV - voltage);
-
-  return resistance;
+  // (voltage * series resistor) / (refV - voltage), with voltage = code / ADC_RES * refV.
+  // refV cancels, so only the raw code is needed.
+  return convertAdcToRes<GaugeConfig::AdcBits>(analogRead(SENSOR_PIN));
 }
 
 
@@ -208,7 +189,7 @@ int getTemp(bool Print)
  ***********************************************************************************/
 unsigned long int getScaledRefRes(unsigned char index)
 {
-  return (unsigned long int)(RESISTANCE_VALS[index]) * RES_SCALE_FACTOR;
+  return (unsigned long int)(pgm_read_word(&RESISTANCE_VALS[index])) * RES_SCALE_FACTOR;
 }
 
 
@@ -216,6 +197,7 @@ unsigned long int getScaledRefRes(unsigned char index)
  * @brief - resToTemp()
  *  Calculates/estimates the current temperature of the thermistor based on the
  *    provided resistance value. Performs linear interpolation to estimate values.
+ *    The math lives in convertResToTemp() so the host tools get identical results.
  * 
  * @param - float Res: Resistance value to return corresponding temperature of
  * @param - bool Print: boolean that makes FW print debug info to the serial port if true.
@@ -224,41 +206,20 @@ unsigned long int getScaledRefRes(unsigned char index)
  ***********************************************************************************/
 float resToTemp(float Res, bool Print)
 {
-    float lookupRes = Res;
-    float temp = 0;
-    float slope;
-
-    // Resistance is less than 
-    if (lookupRes > getScaledRefRes(0))
-    {
-      slope = getSlope(0, 1);
-      temp = TEMP_VALS[0] - (slope * (getScaledRefRes(0) - lookupRes));
-    }
-
-    else if (lookupRes <= getScaledRefRes(NUM_RES_VALUES - 1))
-    {
-      slope = getSlope(NUM_RES_VALUES - 2, NUM_RES_VALUES - 1);
-      temp = TEMP_VALS[NUM_RES_VALUES - 1] + (slope * (lookupRes - getScaledRefRes(NUM_RES_VALUES - 1)));
-    }
-    else
+    if (Print)
     {
       for (int i  = 0; i < NUM_RES_VALUES - 1; i++)
       {
-        if (lookupRes <= getScaledRefRes(i) &&
-            lookupRes > getScaledRefRes(i + 1))
+        if (Res <= getScaledRefRes(i) &&
+            Res > getScaledRefRes(i + 1))
         {
-          if (Print)
-          {
-            Serial.println(String(lookupRes) + " " + getScaledRefRes(i) + " " + getScaledRefRes(i + 1) + " " + String(i) + "\n");
-          }
-          slope = getSlope(i, i + 1);
-          temp = TEMP_VALS[i] + (slope * (lookupRes - getScaledRefRes(i)));
+          Serial.println(String(Res) + " " + getScaledRefRes(i) + " " + getScaledRefRes(i + 1) + " " + String(i) + "\n");
           break;
         }
       }
     }
 
-    return temp;
+    return convertResToTemp(Res);
 }
 
 
@@ -274,7 +235,8 @@ float resToTemp(float Res, bool Print)
  ***********************************************************************************/
 float getSlope(unsigned char ind0, unsigned char ind1)
 {
-   return (float(TEMP_VALS[ind1]) - float(TEMP_VALS[ind0])) / (float(getScaledRefRes(ind1)) - float(getScaledRefRes(ind0)));
+   return (float(pgm_read_word(&TEMP_VALS[ind1])) - float(pgm_read_word(&TEMP_VALS[ind0]))) /
+          (float(getScaledRefRes(ind1)) - float(getScaledRefRes(ind0)));
 }
 
 
@@ -297,9 +259,145 @@ float readVcc()
   uint16_t result = ADC;
 
   // 1.1V * 1023 / result = Vcc in millivolts
-  return 1125300f / float(result); // ~1.1V * 1023 * 1000
+  return 1125300.0f / float(result); // ~1.1V * 1023 * 1000
 
 #else
-  return REF_mV / 1000.0;
+  return GaugeConfig::RefmV / 1000.0;
+#endif
+}
+
+
+/***********************************************************************************
+ * @brief - thermistorBurstCapture()
+ *  Records raw ADC codes from SENSOR_PIN at a fixed rate, blocking. Each sample is
+ *    started on its own slot of the schedule, so one slow read doesn't shift the
+ *    rest. If the ADC can't keep up the samples are counted as late and the
+ *    achieved rate reported in Stats drops below RateHz.
+ *
+ * @param - Samples: Receives Count raw ADC codes
+ * @param - Count: Number of samples
+ * @param - RateHz: Requested sample rate
+ * @param - Stats: Receives the achieved rate, may be 0
+ *
+ * @return - None
+ ***********************************************************************************/
+void thermistorBurstCapture(int16_t * Samples, unsigned int Count, unsigned long RateHz, PTR_BURST_STATS Stats)
+{
+  unsigned long periodUs = 1000000UL / RateHz;
+  unsigned long startUs, lastUs = 0;
+  unsigned long nextUs = micros();
+  unsigned int late = 0;
+
+  startUs = nextUs;
+  for (unsigned int i = 0; i < Count; i++)
+  {
+    while ((long)(micros() - nextUs) < 0)
+    {
+    }
+
+    lastUs = micros();
+    Samples[i] = analogRead(SENSOR_PIN);
+
+    nextUs += periodUs;
+    if ((long)(micros() - nextUs) > 0)
+    {
+      late++;
+    }
+  }
+
+  if (Stats)
+  {
+    Stats->DurationUs = lastUs - startUs;
+    Stats->RateHz = (Count > 1 && Stats->DurationUs) ? float(Count - 1) * 1000000.0 / float(Stats->DurationUs) : 0;
+    Stats->LateSamples = late;
+  }
+}
+
+
+// Kept out of line so its buffers are only pushed once thermistorNoiseReport() has checked they fit
+static void __attribute__((noinline)) noiseReportRun()
+{
+  int16_t samples[BURST_NUM_SAMPLES];
+  float amplitude[SPECTRUM_NUM_BINS + 1];
+  SPECTRUM_PEAK peaks[SPECTRUM_MAX_PEAKS];
+  BURST_STATS burst;
+  unsigned long analyzeUs;
+  unsigned char numPeaks;
+
+  thermistorBurstCapture(samples, BURST_NUM_SAMPLES, BURST_RATE_HZ, &burst);
+
+  analyzeUs = micros();
+  spectrumAnalyze(samples, BURST_NUM_SAMPLES, amplitude);
+  analyzeUs = micros() - analyzeUs;
+
+  numPeaks = spectrumFindPeaks(amplitude, burst.RateHz, peaks, SPECTRUM_MAX_PEAKS);
+
+  // Printed piece by piece, String temporaries would grow the heap into the buffers
+  Serial.println(F("Noise burst"));
+  Serial.print(F("  samples: "));
+  Serial.print(BURST_NUM_SAMPLES);
+  Serial.print(F(" at "));
+  Serial.print(burst.RateHz, 1);
+  Serial.print(F(" Hz (asked "));
+  Serial.print(BURST_RATE_HZ);
+  Serial.print(F("), late: "));
+  Serial.println(burst.LateSamples);
+  Serial.print(F("  capture: "));
+  Serial.print(burst.DurationUs);
+  Serial.print(F(" us, analysis: "));
+  Serial.print(analyzeUs);
+  Serial.print(F(" us, "));
+  Serial.print(float(analyzeUs) * 1000.0 / (float(BURST_NUM_SAMPLES) * SPECTRUM_NUM_BINS), 1);
+  Serial.println(F(" ns per sample-bin"));
+
+  Serial.println(F("  peaks (Hz, ADC codes):"));
+  for (unsigned char i = 0; i < numPeaks; i++)
+  {
+    Serial.print(F("    "));
+    Serial.print(peaks[i].FreqHz, 1);
+    Serial.print(F(", "));
+    Serial.println(peaks[i].Amplitude, 2);
+  }
+
+  Serial.println(F("  bins (Hz, ADC codes):"));
+  for (unsigned int k = 1; k <= SPECTRUM_NUM_BINS; k++)
+  {
+    Serial.print(F("    "));
+    Serial.print(k * burst.RateHz / SPECTRUM_SEG_LEN, 1);
+    Serial.print(F(", "));
+    Serial.println(amplitude[k], 2);
+  }
+}
+
+
+/***********************************************************************************
+ * @brief - thermistorNoiseReport()
+ *  Captures a burst of BURST_NUM_SAMPLES at BURST_RATE_HZ, finds the strongest noise
+ *    frequencies and prints them with the amplitude of every bin, so sample rates
+ *    and notch or decimation filters can be picked for the vehicle's wiring. The
+ *    analysis runs at the achieved rate, not the requested one. Blocks for the
+ *    burst plus the analysis, both timed in the report.
+ *
+ *  On AVR the buffers take a quarter of SRAM, so the report is skipped with a
+ *    message if they don't fit between the heap and the stack.
+ *
+ * @return - None
+ ***********************************************************************************/
+void thermistorNoiseReport()
+{
+#ifdef __AVR__
+  unsigned int freeBytes = sramGetFree();
+
+  if (freeBytes < BURST_STACK_BYTES + BURST_STACK_MARGIN)
+  {
+    Serial.print(F("Noise burst needs "));
+    Serial.print((unsigned int)(BURST_STACK_BYTES + BURST_STACK_MARGIN));
+    Serial.print(F(" bytes of SRAM, "));
+    Serial.print(freeBytes);
+    Serial.println(F(" free"));
+    return;
+  }
 #endif
-}
\ No newline at end of file
+
+  noiseReportRun();
+}
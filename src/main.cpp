@@ -1,14 +1,52 @@
-
 #include "baseChibis.hpp"
+#include "baseHistory.hpp"
+#include "baseTrend.hpp"
+#include "halCapture.hpp"
 #include "halDisplay.hpp"
+#include "halSram.hpp"
+#include "halTempHist.hpp"
 #include "halThermistor.hpp"
 
 #define INIT_DELAY_SEC    2
+#define PEAK_HOLD_SEC     60
+#define BENCHMARK_FRAMES  20
+#define GRAY_DEMO_MS      3000
+#define WIPE_MS           600       // Chibi scrolls away to the gauge after startup
+#define ALERT_FLASH_MS    500       // Inverts the alert screen at 2 Hz
+#define LOOP_DELAY_MS     10        // Spent animating the needle instead when the dial is shown
+#ifdef DISPLAY_PAGE_MODE
+  #define DIAL_FRAME_MS   50        // The whole face is drawn and sent every frame, ~25 ms of I2C
+#else
+  #define DIAL_FRAME_MS   10        // Only the spans the needle moved through are sent
+#endif
 
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-const bool DEBUG = false;
-const bool NUMBERS_DEBUG = false;
-const bool THERMIST_DATA_COLLECTION = true;
+// Debug, NumbersDebug and DataCollection come from GaugeConfig, see gaugeConfig.hpp
+
+// Values sampled once per loop() and shown by the gauge layouts. The draw function
+// may run once per page, so it must not sample anything itself.
+typedef struct _GAUGE_VALUES
+{
+  int Temp;
+  float Res;
+  float Voltage;
+  bool PeakValid;
+  int Peak;
+  float Slope;
+} GAUGE_VALUES, *PTR_GAUGE_VALUES;
+
+GAUGE_VALUES gaugeValues;
+TREND_ALARM_STATE lastAlarm = TREND_ALARM_CLEAR;
+int debugNumber = 0;
+bool showTempHist = false;
+#ifdef GAUGE_START_DIAL
+bool showDial = true;               // Sweep dial instead of the digits, 'd' switches
+#else
+bool showDial = false;
+#endif
+DIAL_NEEDLE gaugeNeedle;
+unsigned long gaugeDialFrameMs = 0;
+bool gaugeDialPending = false;      // A new reading is waiting for the next dial frame
 
 /***************************************************************************************
  * Need to delay for a bit to ensure that voltages have stabilized
@@ -17,80 +55,580 @@ const bool THERMIST_DATA_COLLECTION = true;
 void startupDelay()
 {
   displayBlinkChibi(INIT_DELAY_SEC);
+  displayEffectStart(DISPLAY_EFFECT_WIPE_LEFT, WIPE_MS, 0);
+}
+
+void drawDebugNumber(Adafruit_GFX & Gfx)
+{
+  Gfx.setTextSize(5);
+  Gfx.setTextColor(SSD1306_WHITE);
+  Gfx.setCursor(0, 0);     // Top-left corner
+  Gfx.println(debugNumber);
 }
 
-void numbersDebug()
+void numbersDebug(FEATURE_OFF)
 {
-  for (int i = 0; i < 20; i++)
+}
+
+void numbersDebug(FEATURE_ON)
+{
+  for (debugNumber = 0; debugNumber < 20; debugNumber++)
   {
-    display.clearDisplay();
-    display.setTextSize(5);
-    display.setTextColor(SSD1306_WHITE);
-    display.setCursor(0, 0);     // Top-left corner
-    display.println(String(i));
-    display.display();
+    displayRender(drawDebugNumber);
     delay(100);
   }
 }
 
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-/***********************************
- *     MAIN FIRMWARE SECTION       *
- ***********************************/
+/***************************************************************************************
+ * Prints SRAM left between the heap and the stack. Only meaningful on AVR, where
+ * the whole budget is 2 KB and the display path has to fit inside it.
+ ***************************************************************************************/
+void sramReport()
+{
+#ifdef __AVR__
+  Serial.print(F("Free SRAM: "));
+  Serial.print(sramGetFree());
+  Serial.println(F(" bytes"));
+#endif
+}
 
-// Initialization code. Runs once on power-on.
-void setup() {
-  Serial.begin(9600);
+/***************************************************************************************
+ * Shows the grayscale chibi and prints how steady the dithering was. Below ~50 Hz
+ * cycles, or with high jitter, the gray levels visibly flicker.
+ ***************************************************************************************/
+void grayReport()
+{
+  GRAY_STATS stats;
 
-  displayInit();
+  if (grayShow(&GRAY_HAPPY_CHIBI, GRAY_DEMO_MS, &stats) != GRAY_STATUS_SUCCESS)
+  {
+    Serial.println(F("Gray mode needs DISPLAY_LEAN_DRIVER or DISPLAY_PAGE_MODE"));
+    return;
+  }
 
-  startupDelay();
+  Serial.print(F("Gray: "));
+  Serial.print(stats.Fps);
+  Serial.print(F(" subframes/s, "));
+  Serial.print(stats.CycleHz);
+  Serial.print(F(" Hz cycle, period "));
+  Serial.print(stats.PeriodUs);
+  Serial.print(F(" us ("));
+  Serial.print(stats.MinPeriodUs);
+  Serial.print(F("-"));
+  Serial.print(stats.MaxPeriodUs);
+  Serial.print(F("), jitter "));
+  Serial.print(stats.JitterPct);
+  Serial.print(F("%, late "));
+  Serial.println(stats.LateFrames);
+}
 
-  thermistorMonInit();
+/***************************************************************************************
+ * Single-byte commands from the serial monitor or the host tools:
+ *   c - send one framebuffer capture
+ *   C - stream a capture every loop
+ *       (both refused in DISPLAY_PAGE_MODE, which has no framebuffer)
+ *   x - stop streaming
+ *   h - send the time-at-temperature histogram
+ *   v - switch between the gauge and the histogram bar view
+ *   d - switch between the digits and the dial
+ *   n - capture a burst of raw sensor samples and print its noise spectrum
+ ***************************************************************************************/
+void serialCommandService()
+{
+  while (Serial.available() > 0)
+  {
+    int command = Serial.read();
+
+    switch (command)
+    {
+      case 'c':
+      case 'C':
+        if (!captureRequest(command == 'C'))
+        {
+          Serial.println(F("Capture needs a framebuffer, not DISPLAY_PAGE_MODE"));
+        }
+        break;
+      case 'x':
+        captureStop();
+        break;
+      case 'h':
+        tempHistDump();
+        break;
+      case 'v':
+        showTempHist = !showTempHist;
+        break;
+      case 'd':
+        showDial = !showDial;
+        break;
+      case 'n':
+        thermistorNoiseReport();
+        break;
+      default:
+        break;
+    }
+  }
 }
 
-// Main code that continuously loops forever
-void loop() {
-  display.clearDisplay();
+/***************************************************************************************
+ * Gauge screen, drawn as two layers. Units are drawn once into the background, the
+ * numbers are right-aligned against them in their own regions so only those regions
+ * are redrawn each frame.
+ ***************************************************************************************/
+#define GAUGE_CHAR_W      6         // Default font cell at text size 1
+#define GAUGE_CHAR_H      8
+#define GAUGE_VALUE_X1    84        // Right edge of the value column
+#define GAUGE_UNIT_X      88
+
+const DISPLAY_REGION GAUGE_DATA_REGIONS[] = {
+  { 0,  0, GAUGE_VALUE_X1, 16 },    // Temp
+  { 0, 16, GAUGE_VALUE_X1, 16 },    // Res
+  { 0, 32, GAUGE_VALUE_X1, 16 },    // Voltage
+  { 18, 48, GAUGE_VALUE_X1 - 18, 16 } // Peak, after the "Pk" label
+};
+
+const DISPLAY_REGION GAUGE_TEMP_REGIONS[] = {
+  { 0, 16, 96, 32 }                 // Temp, text size 4
+};
+
+/***************************************************************************************
+ * Draw callbacks run once per page in page mode, so they print numbers directly rather
+ * than building String objects that would churn the heap on every pass.
+ ***************************************************************************************/
+
+// Characters print(Value) writes, sign included
+unsigned char intTextLen(long Value)
+{
+  unsigned char len = (Value < 0) ? 2 : 1;
+  unsigned long mag = (Value < 0) ? -(unsigned long)Value : Value;
+
+  while (mag >= 10)
+  {
+    mag /= 10;
+    len++;
+  }
+  return len;
+}
+
+// Characters print(Value, Decimals) writes. Print rounds half up before printing, and
+// prints "nan", "inf" or "ovf" for values it can't convert, an open sensor for one.
+unsigned char floatTextLen(float Value, unsigned char Decimals)
+{
+  float rounding = 0.5;
+
+  if (isnan(Value) || isinf(Value) || fabs(Value) > 4294967040.0)
+  {
+    return 3;
+  }
+
+  for (unsigned char i = 0; i < Decimals; i++)
+  {
+    rounding /= 10.0;
+  }
+
+  return intTextLen((long)(fabs(Value) + rounding)) + (Value < 0 ? 1 : 0) + (Decimals ? Decimals + 1 : 0);
+}
+
+// Sets the text size and cursor so Len characters end at column X1. Text too wide for
+// the column, which starts at x = 0, drops to a smaller size centered in the same rows
+// rather than running off the left edge. Text wrap is off, so it never spills below.
+void alignRight(Adafruit_GFX & Gfx, unsigned char Len, int16_t X1, int16_t Y, unsigned char Size)
+{
+  unsigned char fit = Size;
+
+  while (fit > 1 && int16_t(Len) * GAUGE_CHAR_W * fit > X1)
+  {
+    fit--;
+  }
+
+  Gfx.setTextWrap(false);
+  Gfx.setTextSize(fit);
+  Gfx.setCursor(X1 - int16_t(Len) * GAUGE_CHAR_W * fit, Y + (Size - fit) * GAUGE_CHAR_H / 2);
+}
+
+// Prints Text so that it ends at column X1
+void printRightAligned(Adafruit_GFX & Gfx, const char * Text, int16_t X1, int16_t Y, unsigned char Size)
+{
+  alignRight(Gfx, strlen(Text), X1, Y, Size);
+  Gfx.print(Text);
+}
+
+void printRightAligned(Adafruit_GFX & Gfx, int Value, int16_t X1, int16_t Y, unsigned char Size)
+{
+  alignRight(Gfx, intTextLen(Value), X1, Y, Size);
+  Gfx.print(Value);
+}
+
+void printRightAligned(Adafruit_GFX & Gfx, float Value, unsigned char Decimals, int16_t X1, int16_t Y, unsigned char Size)
+{
+  alignRight(Gfx, floatTextLen(Value, Decimals), X1, Y, Size);
+  Gfx.print(Value, Decimals);
+}
+
+void drawGaugeDataBackground(Adafruit_GFX & Gfx)
+{
+  Gfx.setTextColor(SSD1306_WHITE);
+  Gfx.setTextSize(2);
+  Gfx.setCursor(GAUGE_UNIT_X, 0);
+  Gfx.print(F("F"));
+  Gfx.setCursor(GAUGE_UNIT_X, 32);
+  Gfx.print(F("V"));
+  Gfx.setCursor(GAUGE_UNIT_X, 48);
+  Gfx.print(F("F"));
+
+  Gfx.setTextSize(1);
+  Gfx.setCursor(GAUGE_UNIT_X, 16 + GAUGE_CHAR_H);
+  Gfx.print(F("Ohms"));
+  Gfx.setCursor(0, 48 + GAUGE_CHAR_H);
+  Gfx.print(F("Pk"));
+}
+
+void drawGaugeDataValues(Adafruit_GFX & Gfx)
+{
+  Gfx.setTextColor(SSD1306_WHITE);
+  printRightAligned(Gfx, gaugeValues.Temp, GAUGE_VALUE_X1, 0, 2);
+  printRightAligned(Gfx, gaugeValues.Res, 2, GAUGE_VALUE_X1, 16, 2);
+  printRightAligned(Gfx, gaugeValues.Voltage, 2, GAUGE_VALUE_X1, 32, 2);
+  if (gaugeValues.PeakValid)
+  {
+    printRightAligned(Gfx, gaugeValues.Peak, GAUGE_VALUE_X1, 48, 2);
+  }
+  else
+  {
+    printRightAligned(Gfx, "--", GAUGE_VALUE_X1, 48, 2);
+  }
+}
+
+void drawGaugeTempBackground(Adafruit_GFX & Gfx)
+{
+  Gfx.setTextColor(SSD1306_WHITE);
+  Gfx.setTextSize(4);
+  Gfx.setCursor(100, 16);
+  Gfx.print(F("F"));
+}
+
+void drawGaugeTempValues(Adafruit_GFX & Gfx)
+{
+  Gfx.setTextColor(SSD1306_WHITE);
+  printRightAligned(Gfx, gaugeValues.Temp, 96, 16, 4);
+}
+
+const DISPLAY_LAYOUT GAUGE_DATA_LAYOUT = {
+  drawGaugeDataBackground, drawGaugeDataValues,
+  GAUGE_DATA_REGIONS, sizeof(GAUGE_DATA_REGIONS) / sizeof(GAUGE_DATA_REGIONS[0])
+};
+
+const DISPLAY_LAYOUT GAUGE_TEMP_LAYOUT = {
+  drawGaugeTempBackground, drawGaugeTempValues,
+  GAUGE_TEMP_REGIONS, sizeof(GAUGE_TEMP_REGIONS) / sizeof(GAUGE_TEMP_REGIONS[0])
+};
 
-  if (DEBUG)
+const DISPLAY_LAYOUT * gaugeLayout()
+{
+  return GaugeConfig::DataCollection ? &GAUGE_DATA_LAYOUT : &GAUGE_TEMP_LAYOUT;
+}
+
+/***************************************************************************************
+ * Dial screen. The face (ticks, labels, hot zone and hub) is the background layer and
+ * is drawn once. The readout under the hub is the only region, the needle is drawn
+ * and erased by displayRenderDial().
+ ***************************************************************************************/
+#define DIAL_MIN_F        100
+#define DIAL_MAX_F        300
+#define DIAL_MAJOR_F      50
+#define DIAL_MINOR_F      10
+#define DIAL_START        DIAL_DEG(180)   // DIAL_MIN_F at 9 o'clock
+#define DIAL_SWEEP        DIAL_DEG(-180)  // Clockwise to DIAL_MAX_F at 3 o'clock
+#define DIAL_CX           64
+#define DIAL_CY           47
+#define DIAL_RADIUS       46
+#define DIAL_LABEL_RADIUS 32
+#define DIAL_HUB_RADIUS   3
+
+const DISPLAY_REGION GAUGE_DIAL_REGIONS[] = {
+  { 40, SCREEN_HEIGHT - GAUGE_CHAR_H, 48, GAUGE_CHAR_H }   // Readout under the hub
+};
+
+int16_t gaugeDialAngle(int Temp)
+{
+  return dialValueToAngle(Temp, DIAL_MIN_F, DIAL_MAX_F, DIAL_START, DIAL_SWEEP);
+}
+
+void drawGaugeDialFace(Adafruit_GFX & Gfx)
+{
+  int16_t x0, y0, x1, y1;
+
+  Gfx.setTextColor(SSD1306_WHITE);
+  Gfx.setTextSize(1);
+
+  for (int t = DIAL_MIN_F; t <= DIAL_MAX_F; t += DIAL_MINOR_F)
   {
-    // If you suspect something is wrong with the screen or 
-    // any connections, set DEBUG = true at the top of this file.
-    // Chibi blink to show that firmware is alive
-    displayBlinkChibi(5);
+    bool major = (t - DIAL_MIN_F) % DIAL_MAJOR_F == 0;
+    int16_t angle = gaugeDialAngle(t);
+
+    dialPoint(DIAL_CX, DIAL_CY, DIAL_RADIUS, angle, &x0, &y0);
+    dialPoint(DIAL_CX, DIAL_CY, DIAL_RADIUS - (major ? 6 : 3), angle, &x1, &y1);
+    Gfx.drawLine(x0, y0, x1, y1, SSD1306_WHITE);
 
-    if (NUMBERS_DEBUG)
+    if (major)
     {
-      numbersDebug();
+      dialPoint(DIAL_CX, DIAL_CY, DIAL_LABEL_RADIUS, angle, &x0, &y0);
+      Gfx.setCursor(x0 - int16_t(intTextLen(t)) * GAUGE_CHAR_W / 2, y0 - GAUGE_CHAR_H / 2);
+      Gfx.print(t);
     }
+  }
+
+  // Hot zone outside the scale, from the alarm temperature up
+  for (int16_t a = gaugeDialAngle(TREND_ALARM_TEMP_F); a >= gaugeDialAngle(DIAL_MAX_F); a -= DIAL_ANGLE_SCALE / 2)
+  {
+    for (int16_t r = DIAL_RADIUS + 1; r <= DIAL_RADIUS + 2; r++)
+    {
+      dialPoint(DIAL_CX, DIAL_CY, r, a, &x0, &y0);
+      Gfx.drawPixel(x0, y0, SSD1306_WHITE);
+    }
+  }
+
+  Gfx.fillCircle(DIAL_CX, DIAL_CY, DIAL_HUB_RADIUS, SSD1306_WHITE);
+}
+
+void drawGaugeDialReadout(Adafruit_GFX & Gfx)
+{
+  unsigned char len = intTextLen(gaugeValues.Temp) + 1;     // Value and "F"
+
+  Gfx.setTextColor(SSD1306_WHITE);
+  Gfx.setTextSize(1);
+  Gfx.setCursor(DIAL_CX - int16_t(len) * GAUGE_CHAR_W / 2, SCREEN_HEIGHT - GAUGE_CHAR_H);
+  Gfx.print(gaugeValues.Temp);
+  Gfx.print('F');
+}
+
+const DISPLAY_DIAL GAUGE_DIAL = {
+  { drawGaugeDialFace, drawGaugeDialReadout,
+    GAUGE_DIAL_REGIONS, sizeof(GAUGE_DIAL_REGIONS) / sizeof(GAUGE_DIAL_REGIONS[0]) },
+  DIAL_CX, DIAL_CY, DIAL_HUB_RADIUS + 1, DIAL_RADIUS - 2
+};
+
+// Draws the dial if the needle moved or a reading is pending, at most once per DIAL_FRAME_MS.
+// The needle eases by the time since its last step, so skipped frames don't slow it down.
+void gaugeDialFrame()
+{
+  unsigned long nowMs = millis();
+
+  if (nowMs - gaugeDialFrameMs < DIAL_FRAME_MS)
+  {
+    return;
+  }
+
+  if (dialNeedleStep(&gaugeNeedle, nowMs) || gaugeDialPending)
+  {
+    displayRenderDial(&GAUGE_DIAL, gaugeNeedle.Angle);
+    gaugeDialFrameMs = nowMs;
+    gaugeDialPending = false;
+  }
+}
+
+// Spends the loop's idle time easing the needle towards the last reading
+void gaugeDialAnimate(unsigned long Ms)
+{
+  unsigned long startMs = millis();
+
+  do
+  {
+    gaugeDialFrame();
+  } while (millis() - startMs < Ms);
+}
+
+/***************************************************************************************
+ * One bar per TEMPHIST_WIDTH_F band, scaled to the fullest band. The top line shows
+ * the covered range and the hours in the fullest band.
+ ***************************************************************************************/
+void drawTempHist(Adafruit_GFX & Gfx)
+{
+  const int barTop = 10;
+  const int barWidth = SCREEN_WIDTH / TEMPHIST_NUM_BUCKETS;
+  uint32_t maxSec = 0;
+
+  for (unsigned char i = 0; i < TEMPHIST_NUM_BUCKETS; i++)
+  {
+    maxSec = max(maxSec, tempHistGetSeconds(i));
+  }
+
+  Gfx.setTextSize(1);
+  Gfx.setTextColor(SSD1306_WHITE);
+  Gfx.setCursor(0, 0);
+  Gfx.print(TEMPHIST_MIN_F);
+  Gfx.print('-');
+  Gfx.print(tempHistGetBucketLowF(TEMPHIST_NUM_BUCKETS));
+  Gfx.print(F("F max "));
+  Gfx.print(maxSec / 3600.0, 1);
+  Gfx.print('h');
 
-    displaySerialDebugPrint(HAPPY_CHIBI);
+  if (maxSec == 0)
+  {
+    return;
+  }
+
+  for (unsigned char i = 0; i < TEMPHIST_NUM_BUCKETS; i++)
+  {
+    int h = ceil(float(tempHistGetSeconds(i)) * (SCREEN_HEIGHT - barTop) / maxSec);
+    Gfx.fillRect(i * barWidth, SCREEN_HEIGHT - h, barWidth - 1, h, SSD1306_WHITE);
   }
-  else 
+}
+
+// Second panel channel, only used when it isn't mirroring the main one
+void drawSecondary(Adafruit_GFX & Gfx)
+{
+  Gfx.setTextSize(2);
+  Gfx.setTextColor(SSD1306_WHITE);
+  Gfx.setCursor(0, 0);
+  Gfx.print(gaugeValues.Slope, 1);
+  Gfx.println(F("F/s"));
+
+  if (gaugeValues.PeakValid)
   {
-    if (THERMIST_DATA_COLLECTION)
+    Gfx.print(F("Pk "));
+    Gfx.print(gaugeValues.Peak);
+    Gfx.println('F');
+  }
+}
+
+void sampleGaugeDetails(FEATURE_OFF)
+{
+}
+
+void sampleGaugeDetails(FEATURE_ON)
+{
+  gaugeValues.Res = getResAvg();
+  gaugeValues.Voltage = getPinVoltage(SENSOR_PIN);
+}
+
+/***************************************************************************************
+ * Screen and timing self-test, built by the seeed_xiao_debug env. Use it if you
+ * suspect something is wrong with the screen or any connections.
+ ***************************************************************************************/
+bool runLoop(FEATURE_ON)
+{
+  // Chibi blink to show that firmware is alive
+  displayBlinkChibi(5);
+
+  numbersDebug(FeatureTag<GaugeConfig::NumbersDebug>());
+
+  displaySerialDebugPrint(HAPPY_CHIBI);
+  sramReport();
+
+  Serial.print(F("Display fps (all panels): "));
+  Serial.println(displayGetFps());
+  displayBenchmark(BENCHMARK_FRAMES);
+  displayBenchmarkLayered(gaugeLayout(), BENCHMARK_FRAMES);
+  displayBenchmarkDial(&GAUGE_DIAL, gaugeDialAngle(DIAL_MIN_F), gaugeDialAngle(DIAL_MAX_F), BENCHMARK_FRAMES);
+  grayReport();
+
+  return false;
+}
+
+/***************************************************************************************
+ * Samples the sensor and draws the gauge, or the alert.
+ *
+ * @return - bool: True if the dial is on screen
+ ***************************************************************************************/
+bool runLoop(FEATURE_OFF)
+{
+  bool dialShown = false;
+
+  // Sampling also runs the predictive alarm on the raw value
+  gaugeValues.Temp = getTempAvg();
+
+  // INVERT_FLASH flashes the alert with invert commands, displayPrintAlert() only sends values that changed
+  if ((trendGetAlarm() != TREND_ALARM_CLEAR) != (lastAlarm != TREND_ALARM_CLEAR))
+  {
+    if (trendGetAlarm() != TREND_ALARM_CLEAR)
     {
-      display.setTextSize(2);  // 2x scale
+      displayEffectStart(DISPLAY_EFFECT_INVERT_FLASH, ALERT_FLASH_MS, 0);
     }
     else
     {
-      display.setTextSize(4); // 4x
+      displayEffectStop();
+    }
+  }
+  lastAlarm = trendGetAlarm();
+
+  if (trendGetAlarm() != TREND_ALARM_CLEAR)
+  {
+    displayPrintAlert(gaugeValues.Temp, trendGetSlope());
+  }
+  else
+  {
+    HIST_STATS peak;
+
+    gaugeValues.PeakValid = (historyGetStats(PEAK_HOLD_SEC, &peak) == HIST_STATUS_SUCCESS);
+    if (gaugeValues.PeakValid)
+    {
+      gaugeValues.Peak = peak.Max;
     }
+    gaugeValues.Slope = trendGetSlope();
 
-    display.setTextColor(SSD1306_WHITE);
-    display.setCursor(0, 0);     // Top-left corner
-    display.println(String(getTempAvg()) + "F");
+    sampleGaugeDetails(FeatureTag<GaugeConfig::DataCollection>());
 
-    if (THERMIST_DATA_COLLECTION)
+    // Push to screen
+    if (showTempHist)
+    {
+      displayRender(drawTempHist);
+    }
+    else if (showDial)
     {
-      display.println(String(getResAvg()) + " Ohms");
-      display.println(String(getPinVoltage(SENSOR_PIN)) + "V");
-      //display.println(String(ADC->CTRLB.bit.RESSEL));
+      dialNeedleSetTarget(&gaugeNeedle, gaugeDialAngle(gaugeValues.Temp));
+      gaugeDialPending = true;
+      gaugeDialFrame();
+      dialShown = true;
     }
-    display.display();           // Push to screen
+    else
+    {
+      displayRenderLayered(gaugeLayout());
+    }
+    displayRender2(drawSecondary);
   }
 
-  Serial.println(F("I'm alive!\r\n"));
-  delay(10);
-}
\ No newline at end of file
+  return dialShown;
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+/***********************************
+ *     MAIN FIRMWARE SECTION       *
+ ***********************************/
+
+// Initialization code. Runs once on power-on.
+void setup() {
+  Serial.begin(9600);
+
+  displayInit();
+
+  startupDelay();
+
+  thermistorMonInit();
+  dialNeedleInit(&gaugeNeedle, gaugeDialAngle(DIAL_MIN_F), millis());   // Sweeps up to the first reading
+
+  sramReport();
+}
+
+// Main code that continuously loops forever
+void loop() {
+  bool dialShown = runLoop(FeatureTag<GaugeConfig::Debug>());
+
+  serialCommandService();
+  displayEffectsService(millis());
+  captureService();
+  tempHistStoreService(millis());
+
+  if (!captureIsStreaming())
+  {
+    Serial.println(F("I'm alive!\r\n"));
+  }
+
+  if (dialShown)
+  {
+    gaugeDialAnimate(LOOP_DELAY_MS);
+  }
+  else
+  {
+    delay(LOOP_DELAY_MS);
+  }
+}
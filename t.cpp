@@ -0,0 +1,23 @@
+#include "halTempHist.hpp"
+#include <stdio.h>
+unsigned char eeMem[1024]; long eeBudget=-1; EEPROMClass EEPROM; Stream Serial;
+static unsigned long ms=0; unsigned long millis(){return ms;}
+void captureWriteRecord(unsigned char, const unsigned char*, unsigned int){}
+int main(){
+  int bad=0;
+  for(int cut=0; cut<=(int)sizeof(TEMPHIST_SLOT)+1; cut++){
+    memset(eeMem,0xFF,sizeof eeMem); eeBudget=-1; ms=0;
+    tempHistStoreInit(); if(tempHistGetTotalSeconds()!=0) bad++;
+    uint32_t totals[8]; unsigned long t=0;
+    for(int s=0;s<4;s++){ for(int k=0;k<10+s;k++){ t+=1000; tempHistAddSample(200,t);} if(s==3) eeBudget=cut; tempHistStoreSave(); totals[s]=tempHistGetTotalSeconds(); }
+    eeBudget=-1;
+    tempHistStoreInit(); uint32_t got=tempHistGetTotalSeconds();
+    bool ok = (cut>=(int)sizeof(TEMPHIST_RECORD)) ? (got==totals[3]||got==totals[2]) : got==totals[2];
+    if(cut>=(int)sizeof(TEMPHIST_SLOT) && got!=totals[3]) ok=false;
+    if(!ok){ bad++; printf("cut %d got %u (t2 %u t3 %u)\n",cut,got,totals[2],totals[3]); }
+    // keeps alternating after reload
+    for(int k=0;k<5;k++){ t+=1000; tempHistAddSample(200,t);} tempHistStoreSave(); uint32_t t5=tempHistGetTotalSeconds(); tempHistStoreInit(); if(tempHistGetTotalSeconds()!=t5){bad++; printf("reload cut %d\n",cut);}
+  }
+  // old single-record layout at address 0 is still picked up
+  printf("bad %d\n",bad);
+}
@@ -0,0 +1,149 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   test_convert.cpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Host tests for the ADC code -> resistance -> temperature conversion
+*   and the boxcar filter. The table conversion is checked against a
+*   plain segment search, in and past both ends of the table.
+*
+*   Run with: pio test -e native -f test_convert
+*
+*/
+
+#include <unity.h>
+#include "baseConvert.hpp"
+
+#define SWEEP_MIN_RES       10.0f       // Past the hot end of the table
+#define SWEEP_MAX_RES       5000.0f     // Past the cold end of the table
+#define SWEEP_STEP_RES      0.25f
+#define SWEEP_COUNT         19961       // (SWEEP_MAX_RES - SWEEP_MIN_RES) / SWEEP_STEP_RES + 1
+
+
+static float tableRes(unsigned char Ind)
+{
+  return float((unsigned long)pgm_read_word(&RESISTANCE_VALS[Ind]) * RES_SCALE_FACTOR);
+}
+
+static float tableTemp(unsigned char Ind)
+{
+  return float(pgm_read_word(&TEMP_VALS[Ind]));
+}
+
+
+// Linear interpolation along the segment Res falls in, outer segments extended
+static float referenceTemp(float Res)
+{
+  unsigned char i = 0;
+
+  while (i < NUM_RES_VALUES - 2 && Res < tableRes(i + 1))
+  {
+    i++;
+  }
+
+  return tableTemp(i) + (Res - tableRes(i)) * (tableTemp(i + 1) - tableTemp(i)) / (tableRes(i + 1) - tableRes(i));
+}
+
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+
+void test_table_points_convert_exactly()
+{
+  for (unsigned char i = 0; i < NUM_RES_VALUES; i++)
+  {
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, tableTemp(i), convertResToTemp(tableRes(i)));
+  }
+}
+
+
+void test_matches_segment_search()
+{
+  for (float res = SWEEP_MIN_RES; res <= SWEEP_MAX_RES; res += SWEEP_STEP_RES)
+  {
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, referenceTemp(res), convertResToTemp(res));
+  }
+}
+
+
+void test_batch_matches_single()
+{
+  static float res[SWEEP_COUNT];
+  static float temps[SWEEP_COUNT];
+
+  for (unsigned int n = 0; n < SWEEP_COUNT; n++)
+  {
+    res[n] = SWEEP_MIN_RES + n * SWEEP_STEP_RES;
+  }
+
+  convertResToTempBatch(res, temps, SWEEP_COUNT);
+  for (unsigned int n = 0; n < SWEEP_COUNT; n++)
+  {
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, convertResToTemp(res[n]), temps[n]);
+  }
+}
+
+
+void test_adc_code_to_resistance()
+{
+  // Mid scale, the thermistor equals the series resistor
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, GaugeConfig::SeriesResistor, convertAdcToRes<12>(2048));
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, GaugeConfig::SeriesResistor, convertAdcToRes(512, 10));
+
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.0f, convertAdcToRes(0, 12));
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, GaugeConfig::SeriesResistor * 3, convertAdcToRes<10>(768));
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, convertAdcToRes(1234, 12), convertAdcToRes<12>(1234));
+}
+
+
+void test_adc_batch_matches_single()
+{
+  uint16_t codes[] = { 1, 100, 1024, 2048, 3000, 4094 };
+  const unsigned long count = sizeof(codes) / sizeof(codes[0]);
+  float res[count];
+  float temps[count];
+  float batchRes[count];
+
+  convertAdcToResBatch(codes, res, count, 12);
+  convertAdcToTempBatch(codes, batchRes, temps, count, 12);
+  for (unsigned long n = 0; n < count; n++)
+  {
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, convertAdcToRes(codes[n], 12), res[n]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, res[n], batchRes[n]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, convertResToTemp(res[n]), temps[n]);
+  }
+}
+
+
+void test_boxcar_average()
+{
+  FIXED_BOXCAR_FILTER<4> filter;
+
+  boxcarInit(&filter, 100);
+  TEST_ASSERT_EQUAL_INT(125, boxcarPush(&filter, 200));
+  TEST_ASSERT_EQUAL_INT(150, boxcarPush(&filter, 200));
+  TEST_ASSERT_EQUAL_INT(175, boxcarPush(&filter, 200));
+  TEST_ASSERT_EQUAL_INT(200, boxcarPush(&filter, 200));
+
+  // Wrapped around, the oldest 200 drops out
+  TEST_ASSERT_EQUAL_INT(150, boxcarPush(&filter, 0));
+}
+
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_table_points_convert_exactly);
+  RUN_TEST(test_matches_segment_search);
+  RUN_TEST(test_batch_matches_single);
+  RUN_TEST(test_adc_code_to_resistance);
+  RUN_TEST(test_adc_batch_matches_single);
+  RUN_TEST(test_boxcar_average);
+  return UNITY_END();
+}
@@ -0,0 +1,280 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   test_history.cpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Host tests for the tiered history store: tier cascade, rounded
+*   means, and the back-fill of gaps between samples.
+*
+*   Run with: pio test -e native -f test_history
+*
+*/
+
+#include <unity.h>
+#include "baseHistory.hpp"
+
+#define MS_PER_DAY      86400000UL
+#define HELD_F          155
+
+typedef struct _TIER_SNAPSHOT
+{
+  unsigned long Closed;
+  unsigned char Num;
+  HIST_BUCKET Buckets[255];
+} TIER_SNAPSHOT, *PTR_TIER_SNAPSHOT;
+
+
+static void snapshotTiers(TIER_SNAPSHOT * Snap)
+{
+  for (unsigned char t = 0; t < HIST_TIER_MAX; t++)
+  {
+    Snap[t].Closed = historyGetNumClosed(HIST_TIER_NUM(t));
+    Snap[t].Num = historyGetNumBuckets(HIST_TIER_NUM(t));
+    for (unsigned char age = 0; age < Snap[t].Num; age++)
+    {
+      historyGetBucket(HIST_TIER_NUM(t), age, &Snap[t].Buckets[age]);
+    }
+  }
+}
+
+
+// Uneven samples, so a gap starts from a part-filled bucket in every tier
+static unsigned long addRun(unsigned long NowMs, unsigned int Count)
+{
+  for (unsigned int i = 0; i < Count; i++)
+  {
+    historyAddSample(150 + (i * 7) % 23, NowMs);
+    NowMs += 300;
+  }
+  return NowMs;
+}
+
+
+// Ends on a second that only holds HELD_F, returns the start of the next second
+static unsigned long addPrefix()
+{
+  unsigned long nowMs = addRun(0, 137);
+  unsigned long nextSecMs = (nowMs / 1000 + 1) * 1000;
+
+  for (; nowMs < nextSecMs; nowMs += 300)
+  {
+    historyAddSample(HELD_F, nowMs);
+  }
+  return nextSecMs;
+}
+
+
+void setUp()
+{
+  historyInit();
+}
+
+void tearDown()
+{
+}
+
+
+void test_no_data_until_first_close()
+{
+  HIST_STATS stats;
+  HIST_BUCKET bucket;
+
+  TEST_ASSERT_EQUAL(HIST_STATUS_NO_DATA, historyGetStats(10, &stats));
+  TEST_ASSERT_EQUAL(HIST_STATUS_INVALID_PARAM, historyGetStats(0, &stats));
+
+  historyAddSample(100, 0);
+  historyAddSample(100, 999);
+  TEST_ASSERT_EQUAL(HIST_STATUS_NO_DATA, historyGetStats(10, &stats));
+  TEST_ASSERT_EQUAL(HIST_STATUS_NO_DATA, historyGetBucket(HIST_TIER_SECONDS, 0, &bucket));
+
+  historyAddSample(100, 1000);
+  TEST_ASSERT_EQUAL(HIST_STATUS_SUCCESS, historyGetStats(10, &stats));
+  TEST_ASSERT_EQUAL_UINT32(1, stats.Seconds);
+}
+
+
+void test_bucket_mean_rounds_to_nearest()
+{
+  HIST_BUCKET bucket;
+
+  // Each block's last sample opens the next second
+  historyAddSample(100, 0);
+  historyAddSample(101, 500);
+  historyAddSample(-100, 1000);
+  historyGetBucket(HIST_TIER_SECONDS, 0, &bucket);
+  TEST_ASSERT_EQUAL_INT16(101, bucket.Mean);
+
+  historyAddSample(-101, 1500);
+  historyAddSample(100, 2000);
+  historyGetBucket(HIST_TIER_SECONDS, 0, &bucket);
+  TEST_ASSERT_EQUAL_INT16(-101, bucket.Mean);
+
+  historyAddSample(100, 2300);
+  historyAddSample(101, 2600);
+  historyAddSample(0, 3000);
+  historyGetBucket(HIST_TIER_SECONDS, 0, &bucket);
+  TEST_ASSERT_EQUAL_INT16(100, bucket.Mean);
+}
+
+
+void test_stats_mean_rounds_to_nearest()
+{
+  HIST_STATS stats;
+
+  historyAddSample(100, 0);
+  historyAddSample(101, 1000);
+  historyAddSample(0, 2000);
+
+  TEST_ASSERT_EQUAL(HIST_STATUS_SUCCESS, historyGetStats(2, &stats));
+  TEST_ASSERT_EQUAL_INT16(100, stats.Min);
+  TEST_ASSERT_EQUAL_INT16(101, stats.Max);
+  TEST_ASSERT_EQUAL_INT16(101, stats.Mean);
+  TEST_ASSERT_EQUAL_UINT32(2, stats.Seconds);
+}
+
+
+void test_tiers_cascade()
+{
+  HIST_BUCKET bucket;
+  HIST_STATS stats;
+
+  // One sample per second, the value is the second. The 601st sample closes second 599.
+  for (int s = 0; s <= 600; s++)
+  {
+    historyAddSample(s, s * 1000UL);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(600, historyGetNumClosed(HIST_TIER_SECONDS));
+  TEST_ASSERT_EQUAL_UINT32(60, historyGetNumClosed(HIST_TIER_10_SECONDS));
+  TEST_ASSERT_EQUAL_UINT32(10, historyGetNumClosed(HIST_TIER_MINUTES));
+
+  TEST_ASSERT_EQUAL(HIST_STATUS_SUCCESS, historyGetBucket(HIST_TIER_10_SECONDS, 0, &bucket));
+  TEST_ASSERT_EQUAL_INT16(590, bucket.Min);
+  TEST_ASSERT_EQUAL_INT16(599, bucket.Max);
+  TEST_ASSERT_EQUAL_INT16(595, bucket.Mean);
+
+  TEST_ASSERT_EQUAL(HIST_STATUS_SUCCESS, historyGetBucket(HIST_TIER_MINUTES, 0, &bucket));
+  TEST_ASSERT_EQUAL_INT16(540, bucket.Min);
+  TEST_ASSERT_EQUAL_INT16(599, bucket.Max);
+  TEST_ASSERT_EQUAL_INT16(570, bucket.Mean);
+
+  // Longer than the per-second tier holds, so it is answered from the 10 s tier
+  TEST_ASSERT_EQUAL(HIST_STATUS_SUCCESS, historyGetStats(HIST_TIER0_LEN + 1, &stats));
+  TEST_ASSERT_EQUAL_UINT32(0, stats.Seconds % HIST_TIER1_SEC_PER_BUCKET);
+  TEST_ASSERT_EQUAL_INT16(599, stats.Max);
+}
+
+
+void test_gap_is_back_filled()
+{
+  HIST_STATS stats;
+  HIST_BUCKET bucket;
+
+  historyAddSample(100, 0);
+  historyAddSample(100, 500);
+  historyAddSample(200, 5000);
+  TEST_ASSERT_EQUAL_UINT32(5, historyGetNumClosed(HIST_TIER_SECONDS));
+
+  historyAddSample(200, 6000);
+  TEST_ASSERT_EQUAL_UINT32(6, historyGetNumClosed(HIST_TIER_SECONDS));
+
+  historyGetBucket(HIST_TIER_SECONDS, 0, &bucket);
+  TEST_ASSERT_EQUAL_INT16(200, bucket.Mean);
+  for (unsigned char age = 1; age < 6; age++)
+  {
+    historyGetBucket(HIST_TIER_SECONDS, age, &bucket);
+    TEST_ASSERT_EQUAL_INT16(100, bucket.Mean);
+  }
+
+  TEST_ASSERT_EQUAL(HIST_STATUS_SUCCESS, historyGetStats(6, &stats));
+  TEST_ASSERT_EQUAL_UINT32(6, stats.Seconds);
+  TEST_ASSERT_EQUAL_INT16(100, stats.Min);
+  TEST_ASSERT_EQUAL_INT16(200, stats.Max);
+  TEST_ASSERT_EQUAL_INT16(117, stats.Mean);
+}
+
+
+static void assertSnapshotsEqual(const TIER_SNAPSHOT * Expected, const TIER_SNAPSHOT * Actual)
+{
+  for (unsigned char t = 0; t < HIST_TIER_MAX; t++)
+  {
+    TEST_ASSERT_EQUAL_UINT32(Expected[t].Closed, Actual[t].Closed);
+    TEST_ASSERT_EQUAL_UINT8(Expected[t].Num, Actual[t].Num);
+    for (unsigned char age = 0; age < Actual[t].Num; age++)
+    {
+      TEST_ASSERT_EQUAL_INT16(Expected[t].Buckets[age].Min, Actual[t].Buckets[age].Min);
+      TEST_ASSERT_EQUAL_INT16(Expected[t].Buckets[age].Max, Actual[t].Buckets[age].Max);
+      TEST_ASSERT_EQUAL_INT16(Expected[t].Buckets[age].Mean, Actual[t].Buckets[age].Mean);
+    }
+  }
+}
+
+
+// The bounded fill has to leave every tier as if the held value had been sampled once a second
+void test_back_fill_matches_sampling()
+{
+  static TIER_SNAPSHOT filled[2][HIST_TIER_MAX];
+  static TIER_SNAPSHOT sampled[2][HIST_TIER_MAX];
+  const unsigned long gapSec = 9001;
+  unsigned long startMs;
+
+  // Checked right after the gap, and again once every tier has closed the bucket it left pending
+  startMs = addPrefix();
+  addRun(startMs + gapSec * 1000 + 250, 1);
+  snapshotTiers(filled[0]);
+  addRun(startMs + gapSec * 1000 + 550, 2500);
+  snapshotTiers(filled[1]);
+
+  historyInit();
+  startMs = addPrefix();
+  for (unsigned long s = 0; s < gapSec; s++)
+  {
+    historyAddSample(HELD_F, startMs + s * 1000);
+  }
+  addRun(startMs + gapSec * 1000 + 250, 1);
+  snapshotTiers(sampled[0]);
+  addRun(startMs + gapSec * 1000 + 550, 2500);
+  snapshotTiers(sampled[1]);
+
+  assertSnapshotsEqual(sampled[0], filled[0]);
+  assertSnapshotsEqual(sampled[1], filled[1]);
+}
+
+
+void test_long_gap_counts_every_bucket()
+{
+  HIST_BUCKET bucket;
+  const unsigned long gapMs = 3 * MS_PER_DAY;
+
+  historyAddSample(150, 0);
+  historyAddSample(150, gapMs);
+
+  TEST_ASSERT_EQUAL_UINT32(gapMs / 1000, historyGetNumClosed(HIST_TIER_SECONDS));
+  TEST_ASSERT_EQUAL_UINT32(gapMs / (1000UL * HIST_TIER1_SEC_PER_BUCKET), historyGetNumClosed(HIST_TIER_10_SECONDS));
+  TEST_ASSERT_EQUAL_UINT32(gapMs / (1000UL * HIST_TIER2_SEC_PER_BUCKET), historyGetNumClosed(HIST_TIER_MINUTES));
+
+  TEST_ASSERT_EQUAL_UINT8(HIST_TIER0_LEN, historyGetNumBuckets(HIST_TIER_SECONDS));
+  TEST_ASSERT_EQUAL_UINT8(HIST_TIER1_LEN, historyGetNumBuckets(HIST_TIER_10_SECONDS));
+  TEST_ASSERT_EQUAL_UINT8(HIST_TIER2_LEN, historyGetNumBuckets(HIST_TIER_MINUTES));
+
+  for (unsigned char age = 0; age < HIST_TIER2_LEN; age++)
+  {
+    historyGetBucket(HIST_TIER_MINUTES, age, &bucket);
+    TEST_ASSERT_EQUAL_INT16(150, bucket.Min);
+    TEST_ASSERT_EQUAL_INT16(150, bucket.Max);
+  }
+}
+
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_no_data_until_first_close);
+  RUN_TEST(test_bucket_mean_rounds_to_nearest);
+  RUN_TEST(test_stats_mean_rounds_to_nearest);
+  RUN_TEST(test_tiers_cascade);
+  RUN_TEST(test_gap_is_back_filled);
+  RUN_TEST(test_back_fill_matches_sampling);
+  RUN_TEST(test_long_gap_counts_every_bucket);
+  return UNITY_END();
+}
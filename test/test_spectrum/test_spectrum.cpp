@@ -0,0 +1,122 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   test_spectrum.cpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Host tests for the burst noise analysis: tones on and between bins
+*   are found at their frequency and amplitude, and a flat burst has
+*   no peaks.
+*
+*   Run with: pio test -e native -f test_spectrum
+*
+*/
+
+#include <math.h>
+#include <unity.h>
+#include "baseSpectrum.hpp"
+
+#define RATE_HZ             2000.0f
+#define NUM_SAMPLES         (16 * SPECTRUM_SEG_LEN)
+#define DC_CODE             2400
+#define BIN_HZ              (RATE_HZ / SPECTRUM_SEG_LEN)
+
+int16_t samples[NUM_SAMPLES];
+float amplitude[SPECTRUM_NUM_BINS + 1];
+
+
+static void makeTone(float FreqHz, float Amp)
+{
+  for (unsigned int n = 0; n < NUM_SAMPLES; n++)
+  {
+    samples[n] = (int16_t)lroundf(DC_CODE + Amp * sinf(2.0f * float(M_PI) * FreqHz * n / RATE_HZ));
+  }
+}
+
+
+void setUp()
+{
+  spectrumInit();
+}
+
+void tearDown()
+{
+}
+
+
+void test_rejects_short_burst()
+{
+  makeTone(0, 0);
+  TEST_ASSERT_EQUAL(SPECTRUM_STATUS_INVALID_PARAM, spectrumAnalyze(samples, SPECTRUM_SEG_LEN - 1, amplitude));
+  TEST_ASSERT_EQUAL(SPECTRUM_STATUS_INVALID_PARAM, spectrumAnalyze(0, NUM_SAMPLES, amplitude));
+}
+
+
+void test_flat_burst_has_no_peaks()
+{
+  SPECTRUM_PEAK peaks[SPECTRUM_MAX_PEAKS];
+
+  makeTone(0, 0);
+  TEST_ASSERT_EQUAL(SPECTRUM_STATUS_SUCCESS, spectrumAnalyze(samples, NUM_SAMPLES, amplitude));
+  TEST_ASSERT_EQUAL_UINT8(0, spectrumFindPeaks(amplitude, RATE_HZ, peaks, SPECTRUM_MAX_PEAKS));
+}
+
+
+void test_tone_on_a_bin()
+{
+  SPECTRUM_PEAK peaks[SPECTRUM_MAX_PEAKS];
+  const float freqHz = 8 * BIN_HZ;
+
+  makeTone(freqHz, 30.0f);
+  TEST_ASSERT_EQUAL(SPECTRUM_STATUS_SUCCESS, spectrumAnalyze(samples, NUM_SAMPLES, amplitude));
+  TEST_ASSERT_TRUE(spectrumFindPeaks(amplitude, RATE_HZ, peaks, SPECTRUM_MAX_PEAKS) >= 1);
+
+  TEST_ASSERT_FLOAT_WITHIN(0.05f * BIN_HZ, freqHz, peaks[0].FreqHz);
+  TEST_ASSERT_FLOAT_WITHIN(1.5f, 30.0f, peaks[0].Amplitude);
+}
+
+
+void test_tone_between_bins()
+{
+  SPECTRUM_PEAK peaks[SPECTRUM_MAX_PEAKS];
+  const float freqHz = 13.4f * BIN_HZ;
+
+  makeTone(freqHz, 30.0f);
+  TEST_ASSERT_EQUAL(SPECTRUM_STATUS_SUCCESS, spectrumAnalyze(samples, NUM_SAMPLES, amplitude));
+  TEST_ASSERT_TRUE(spectrumFindPeaks(amplitude, RATE_HZ, peaks, SPECTRUM_MAX_PEAKS) >= 1);
+
+  // The parabola fit lands within a fraction of a bin, the Hann window keeps most of the amplitude
+  TEST_ASSERT_FLOAT_WITHIN(0.25f * BIN_HZ, freqHz, peaks[0].FreqHz);
+  TEST_ASSERT_TRUE(peaks[0].Amplitude > 0.6f * 30.0f);
+}
+
+
+void test_peaks_are_strongest_first()
+{
+  SPECTRUM_PEAK peaks[SPECTRUM_MAX_PEAKS];
+  const float lowHz = 5 * BIN_HZ;
+  const float highHz = 20 * BIN_HZ;
+
+  for (unsigned int n = 0; n < NUM_SAMPLES; n++)
+  {
+    samples[n] = (int16_t)lroundf(DC_CODE + 10.0f * sinf(2.0f * float(M_PI) * lowHz * n / RATE_HZ)
+                                          + 40.0f * sinf(2.0f * float(M_PI) * highHz * n / RATE_HZ));
+  }
+
+  TEST_ASSERT_EQUAL(SPECTRUM_STATUS_SUCCESS, spectrumAnalyze(samples, NUM_SAMPLES, amplitude));
+  TEST_ASSERT_TRUE(spectrumFindPeaks(amplitude, RATE_HZ, peaks, SPECTRUM_MAX_PEAKS) >= 2);
+  TEST_ASSERT_FLOAT_WITHIN(0.05f * BIN_HZ, highHz, peaks[0].FreqHz);
+  TEST_ASSERT_FLOAT_WITHIN(0.05f * BIN_HZ, lowHz, peaks[1].FreqHz);
+  TEST_ASSERT_TRUE(peaks[0].Amplitude > peaks[1].Amplitude);
+}
+
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_rejects_short_burst);
+  RUN_TEST(test_flat_burst_has_no_peaks);
+  RUN_TEST(test_tone_on_a_bin);
+  RUN_TEST(test_tone_between_bins);
+  RUN_TEST(test_peaks_are_strongest_first);
+  return UNITY_END();
+}
@@ -0,0 +1,178 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   test_temphist.cpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Host tests for the time-at-temperature histogram: band edges, the
+*   gap limit, carried fractions of a second, and the saved record.
+*
+*   Run with: pio test -e native -f test_temphist
+*
+*/
+
+#include <unity.h>
+#include "baseTempHist.hpp"
+
+#define LAST_BUCKET     (TEMPHIST_NUM_BUCKETS - 1)
+
+
+// Counts one second at Temp, the second sample only closes it out
+static void addOneSecond(int Temp)
+{
+  tempHistInit();
+  tempHistAddSample(Temp, 0);
+  tempHistAddSample(Temp, 1000);
+}
+
+
+void setUp()
+{
+  tempHistInit();
+}
+
+void tearDown()
+{
+}
+
+
+void test_band_edges()
+{
+  TEST_ASSERT_EQUAL_INT(TEMPHIST_MIN_F, tempHistGetBucketLowF(1));
+  TEST_ASSERT_EQUAL_INT(TEMPHIST_MIN_F + TEMPHIST_WIDTH_F, tempHistGetBucketLowF(2));
+
+  addOneSecond(TEMPHIST_MIN_F - 1);
+  TEST_ASSERT_EQUAL_UINT32(1, tempHistGetSeconds(0));
+
+  addOneSecond(TEMPHIST_MIN_F);
+  TEST_ASSERT_EQUAL_UINT32(1, tempHistGetSeconds(1));
+
+  addOneSecond(TEMPHIST_MIN_F + TEMPHIST_WIDTH_F - 1);
+  TEST_ASSERT_EQUAL_UINT32(1, tempHistGetSeconds(1));
+
+  addOneSecond(TEMPHIST_MIN_F + TEMPHIST_WIDTH_F);
+  TEST_ASSERT_EQUAL_UINT32(1, tempHistGetSeconds(2));
+
+  addOneSecond(tempHistGetBucketLowF(LAST_BUCKET));
+  TEST_ASSERT_EQUAL_UINT32(1, tempHistGetSeconds(LAST_BUCKET));
+}
+
+
+void test_out_of_range_clamps()
+{
+  addOneSecond(-40);
+  TEST_ASSERT_EQUAL_UINT32(1, tempHistGetSeconds(0));
+
+  addOneSecond(1000);
+  TEST_ASSERT_EQUAL_UINT32(1, tempHistGetSeconds(LAST_BUCKET));
+
+  TEST_ASSERT_EQUAL_UINT32(0, tempHistGetSeconds(TEMPHIST_NUM_BUCKETS));
+}
+
+
+void test_time_counts_towards_previous_sample()
+{
+  tempHistAddSample(100, 0);
+  tempHistAddSample(200, 3000);
+  tempHistAddSample(200, 4000);
+
+  TEST_ASSERT_EQUAL_UINT32(3, tempHistGetSeconds(3));
+  TEST_ASSERT_EQUAL_UINT32(1, tempHistGetSeconds(8));
+  TEST_ASSERT_EQUAL_UINT32(4, tempHistGetTotalSeconds());
+}
+
+
+void test_long_gaps_are_not_counted()
+{
+  tempHistAddSample(100, 0);
+  tempHistAddSample(100, TEMPHIST_MAX_GAP_MS);
+  TEST_ASSERT_EQUAL_UINT32(TEMPHIST_MAX_GAP_MS / 1000, tempHistGetTotalSeconds());
+
+  tempHistAddSample(100, 2 * TEMPHIST_MAX_GAP_MS + 1);
+  TEST_ASSERT_EQUAL_UINT32(TEMPHIST_MAX_GAP_MS / 1000, tempHistGetTotalSeconds());
+
+  // Counting picks up again from the sample after the gap
+  tempHistAddSample(100, 2 * TEMPHIST_MAX_GAP_MS + 1001);
+  TEST_ASSERT_EQUAL_UINT32(TEMPHIST_MAX_GAP_MS / 1000 + 1, tempHistGetTotalSeconds());
+}
+
+
+void test_fractions_carry_over()
+{
+  unsigned long nowMs = 0;
+
+  for (int i = 0; i < 10; i++)
+  {
+    tempHistAddSample(100, nowMs);
+    nowMs += 300;
+  }
+
+  // Nine 300 ms steps
+  TEST_ASSERT_EQUAL_UINT32(2, tempHistGetTotalSeconds());
+  tempHistAddSample(100, nowMs);
+  TEST_ASSERT_EQUAL_UINT32(3, tempHistGetTotalSeconds());
+}
+
+
+void test_seal_and_restore()
+{
+  TEMPHIST_RECORD saved;
+
+  tempHistAddSample(100, 0);
+  tempHistAddSample(250, 4000);
+  tempHistAddSample(250, 6000);
+  saved = *tempHistSeal();
+
+  tempHistInit();
+  TEST_ASSERT_EQUAL_UINT32(0, tempHistGetTotalSeconds());
+
+  TEST_ASSERT_EQUAL(TEMPHIST_STATUS_SUCCESS, tempHistRestore(&saved));
+  TEST_ASSERT_EQUAL_UINT32(4, tempHistGetSeconds(3));
+  TEST_ASSERT_EQUAL_UINT32(2, tempHistGetSeconds(10));
+  TEST_ASSERT_EQUAL_UINT32(6, tempHistGetTotalSeconds());
+}
+
+
+void test_restore_rejects_bad_record()
+{
+  TEMPHIST_RECORD saved;
+  TEMPHIST_RECORD bad;
+
+  addOneSecond(100);
+  saved = *tempHistSeal();
+
+  tempHistInit();
+  tempHistAddSample(300, 0);
+  tempHistAddSample(300, 2000);
+
+  bad = saved;
+  bad.Seconds[3]++;
+  TEST_ASSERT_EQUAL(TEMPHIST_STATUS_INVALID_RECORD, tempHistRestore(&bad));
+
+  bad = saved;
+  bad.Magic = 0xFFFF;
+  TEST_ASSERT_EQUAL(TEMPHIST_STATUS_INVALID_RECORD, tempHistRestore(&bad));
+
+  bad = saved;
+  bad.Version++;
+  TEST_ASSERT_EQUAL(TEMPHIST_STATUS_INVALID_RECORD, tempHistRestore(&bad));
+
+  TEST_ASSERT_EQUAL(TEMPHIST_STATUS_INVALID_PARAM, tempHistRestore(0));
+
+  // The live counts are untouched
+  TEST_ASSERT_EQUAL_UINT32(2, tempHistGetSeconds(13));
+  TEST_ASSERT_EQUAL_UINT32(2, tempHistGetTotalSeconds());
+}
+
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_band_edges);
+  RUN_TEST(test_out_of_range_clamps);
+  RUN_TEST(test_time_counts_towards_previous_sample);
+  RUN_TEST(test_long_gaps_are_not_counted);
+  RUN_TEST(test_fractions_carry_over);
+  RUN_TEST(test_seal_and_restore);
+  RUN_TEST(test_restore_rejects_bad_record);
+  return UNITY_END();
+}
@@ -0,0 +1,191 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   test_trend.cpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Host tests for the rate-of-change fit and the over-temperature
+*   alarm: set, predict, and clear with hysteresis.
+*
+*   Run with: pio test -e native -f test_trend
+*
+*/
+
+#include <unity.h>
+#include "baseTrend.hpp"
+
+#define BUCKET_AGE_SEC      1       // Matches BUCKET_AGE_SEC in baseTrend.cpp
+
+
+// One sample at the start of each second, fed the way the gauge loop does it
+static TREND_ALARM_STATE addSecond(int Temp, unsigned long Sec)
+{
+  historyAddSample(Temp, Sec * 1000);
+  return trendAddSample(Temp, Sec * 1000);
+}
+
+
+void setUp()
+{
+  historyInit();
+  trendInit();
+}
+
+void tearDown()
+{
+}
+
+
+void test_ramp_gives_slope_and_prediction()
+{
+  unsigned long sec;
+
+  for (sec = 0; sec <= TREND_WINDOW_SEC + 5; sec++)
+  {
+    addSecond(100 + 2 * sec, sec);
+  }
+
+  // The newest closed bucket is the previous second's sample
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 2.0f, trendGetSlope());
+  TEST_ASSERT_EQUAL_INT(100 + 2 * (sec - 2) + 2 * (BUCKET_AGE_SEC + TREND_HORIZON_SEC), trendGetPrediction());
+}
+
+
+void test_steady_temperature_has_no_slope()
+{
+  for (unsigned long sec = 0; sec <= TREND_WINDOW_SEC + 5; sec++)
+  {
+    TEST_ASSERT_EQUAL(TREND_ALARM_CLEAR, addSecond(250, sec));
+  }
+
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, trendGetSlope());
+  TEST_ASSERT_EQUAL_INT(250, trendGetPrediction());
+}
+
+
+void test_over_temp_sets_on_the_sample()
+{
+  unsigned long sec;
+
+  for (sec = 0; sec < TREND_WINDOW_SEC + 5; sec++)
+  {
+    addSecond(200, sec);
+  }
+
+  TEST_ASSERT_EQUAL(TREND_ALARM_CLEAR, addSecond(TREND_ALARM_TEMP_F - 1, sec++));
+  TEST_ASSERT_EQUAL(TREND_ALARM_OVER_TEMP, addSecond(TREND_ALARM_TEMP_F, sec));
+  TEST_ASSERT_EQUAL_UINT32(sec * 1000, trendGetAlarmSetMs());
+}
+
+
+void test_over_temp_before_window_fills()
+{
+  TEST_ASSERT_EQUAL(TREND_ALARM_OVER_TEMP, addSecond(TREND_ALARM_TEMP_F + 20, 0));
+  TEST_ASSERT_EQUAL_UINT32(0, trendGetAlarmSetMs());
+}
+
+
+void test_prediction_needs_full_window()
+{
+  const int startF = 150;
+  const int slopeF = 4;
+  unsigned long sec;
+
+  // A steep ramp predicts the threshold within a few seconds, but the fit isn't trusted yet
+  for (sec = 0; sec < TREND_WINDOW_SEC; sec++)
+  {
+    TEST_ASSERT_EQUAL(TREND_ALARM_CLEAR, addSecond(startF + slopeF * sec, sec));
+  }
+  TEST_ASSERT_TRUE(trendGetPrediction() >= TREND_ALARM_TEMP_F);
+
+  TEST_ASSERT_EQUAL(TREND_ALARM_PREDICTED, addSecond(startF + slopeF * sec, sec));
+  TEST_ASSERT_TRUE(startF + slopeF * int(sec) < TREND_ALARM_TEMP_F);
+  TEST_ASSERT_EQUAL_UINT32(sec * 1000, trendGetAlarmSetMs());
+}
+
+
+void test_predicted_escalates_to_over_temp()
+{
+  unsigned long sec = 0;
+  unsigned long setMs;
+  int temp = 150;
+
+  while (addSecond(temp, sec) == TREND_ALARM_CLEAR)
+  {
+    temp += 4;
+    sec++;
+  }
+  TEST_ASSERT_EQUAL(TREND_ALARM_PREDICTED, trendGetAlarm());
+  setMs = trendGetAlarmSetMs();
+
+  while (temp < TREND_ALARM_TEMP_F)
+  {
+    temp += 4;
+    TEST_ASSERT_NOT_EQUAL(TREND_ALARM_CLEAR, addSecond(temp, ++sec));
+  }
+  TEST_ASSERT_EQUAL(TREND_ALARM_OVER_TEMP, trendGetAlarm());
+
+  // Time of the first sample that left the clear state
+  TEST_ASSERT_EQUAL_UINT32(setMs, trendGetAlarmSetMs());
+}
+
+
+void test_clears_with_hysteresis()
+{
+  const int insideBandF = TREND_ALARM_TEMP_F - TREND_ALARM_HYST_F / 2;
+  const int belowBandF = TREND_ALARM_TEMP_F - 2 * TREND_ALARM_HYST_F;
+  unsigned long sec = 0;
+
+  for (; sec < TREND_WINDOW_SEC + 5; sec++)
+  {
+    addSecond(TREND_ALARM_TEMP_F + 20, sec);
+  }
+  TEST_ASSERT_EQUAL(TREND_ALARM_OVER_TEMP, trendGetAlarm());
+
+  // Below the threshold but not by the hysteresis, so the alarm holds
+  for (unsigned long end = sec + TREND_WINDOW_SEC + 5; sec < end; sec++)
+  {
+    TEST_ASSERT_NOT_EQUAL(TREND_ALARM_CLEAR, addSecond(insideBandF, sec));
+  }
+
+  // Far enough below, but the fit still holds the last bucket in the band
+  TEST_ASSERT_NOT_EQUAL(TREND_ALARM_CLEAR, addSecond(belowBandF, sec++));
+
+  // Clears once the fit has caught up with the sample
+  for (unsigned long end = sec + TREND_WINDOW_SEC; sec < end; sec++)
+  {
+    addSecond(belowBandF, sec);
+  }
+  TEST_ASSERT_EQUAL(TREND_ALARM_CLEAR, trendGetAlarm());
+}
+
+
+void test_gap_refills_window()
+{
+  unsigned long sec;
+
+  for (sec = 0; sec <= TREND_WINDOW_SEC + 5; sec++)
+  {
+    addSecond(200, sec);
+  }
+
+  // Back-filled seconds hold the last value, the fit sees a flat line up to the new sample
+  addSecond(230, sec + 60);
+  addSecond(230, sec + 61);
+  TEST_ASSERT_TRUE(trendGetSlope() > 0.0f);
+  TEST_ASSERT_EQUAL(TREND_ALARM_CLEAR, trendGetAlarm());
+}
+
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_ramp_gives_slope_and_prediction);
+  RUN_TEST(test_steady_temperature_has_no_slope);
+  RUN_TEST(test_over_temp_sets_on_the_sample);
+  RUN_TEST(test_over_temp_before_window_fills);
+  RUN_TEST(test_prediction_needs_full_window);
+  RUN_TEST(test_predicted_escalates_to_over_temp);
+  RUN_TEST(test_clears_with_hysteresis);
+  RUN_TEST(test_gap_refills_window);
+  return UNITY_END();
+}
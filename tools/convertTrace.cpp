@@ -0,0 +1,326 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   convertTrace.cpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Host tool that streams a recorded trace of raw ADC codes through the
+*   same conversion and filter chain the firmware runs in getTempAvg():
+*
+*     code -> convertAdcToTempBatch() -> int temp -> boxcar average
+*                                                 -> history store
+*                                                 -> slope / predictive alarm
+*
+*   Build from the repo root:
+*     g++ -O3 -march=native -Iinclude tools/convertTrace.cpp src/baseConvert.cpp \
+*         src/baseHistory.cpp src/baseTrend.cpp -o convertTrace
+*
+*   Usage:
+*     convertTrace [--bin] [--bits N] [--rate HZ] [--quiet] [FILE]
+*     convertTrace --ramp FROM,TO,SEC [--noise N] [--bits N] [--rate HZ] [--quiet]
+*
+*     CSV input (default): one sample per line, either "code" or "time_ms,code".
+*     Binary input (--bin): little-endian uint16 codes, timed by --rate.
+*     Reads stdin when FILE is omitted. Writes one CSV line per sample to
+*     stdout unless --quiet, and throughput and alarm latency to stderr.
+*     The average is GaugeConfig::NumSamples long, as in the firmware. Add
+*     -D__AVR__ -DGAUGE_CONFIG_NANO to the build line for the nano's.
+*
+*     --ramp makes a synthetic trace instead: the codes of a linear ramp
+*     from FROM to TO degrees F over SEC seconds, plus up to +-N codes of
+*     uniform noise. E.g. the alarm latency check on seeed_xiao:
+*       convertTrace --ramp 200,300,600 --rate 10 --quiet
+*
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "baseConvert.hpp"
+#include "baseHistory.hpp"
+#include "baseTrend.hpp"
+
+#define BLOCK_LEN           4096        // Samples converted per batch call
+#define DEFAULT_ADC_BITS    GaugeConfig::AdcBits        // Default config, seeed_xiao
+#define DEFAULT_RATE_HZ     100
+
+typedef struct _TRACE_OPTIONS
+{
+  bool Binary;
+  bool Quiet;
+  unsigned char AdcBits;
+  double RateHz;
+  const char * Path;
+  bool Ramp;
+  double RampFromF;
+  double RampToF;
+  double RampSec;
+  int NoiseCodes;
+} TRACE_OPTIONS, *PTR_TRACE_OPTIONS;
+
+// When a filter output first crossed the alarm temperature. -1 = never.
+typedef struct _LATENCY_MARKS
+{
+  long RawCrossMs;
+  long AvgCrossMs;
+  long AlarmSetMs;
+} LATENCY_MARKS, *PTR_LATENCY_MARKS;
+
+
+static double nowSec()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+static void usage()
+{
+  fprintf(stderr, "usage: convertTrace [--bin] [--bits N] [--rate HZ] [--quiet] [FILE]\n"
+                  "       convertTrace --ramp FROM,TO,SEC [--noise N] [--bits N] [--rate HZ] [--quiet]\n");
+  exit(2);
+}
+
+
+static void parseArgs(int argc, char ** argv, PTR_TRACE_OPTIONS Opts)
+{
+  Opts->Binary = false;
+  Opts->Quiet = false;
+  Opts->AdcBits = DEFAULT_ADC_BITS;
+  Opts->RateHz = DEFAULT_RATE_HZ;
+  Opts->Path = 0;
+  Opts->Ramp = false;
+  Opts->NoiseCodes = 0;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (!strcmp(argv[i], "--bin"))                      Opts->Binary = true;
+    else if (!strcmp(argv[i], "--quiet"))               Opts->Quiet = true;
+    else if (!strcmp(argv[i], "--bits") && i + 1 < argc) Opts->AdcBits = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--rate") && i + 1 < argc) Opts->RateHz = atof(argv[++i]);
+    else if (!strcmp(argv[i], "--noise") && i + 1 < argc) Opts->NoiseCodes = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--ramp") && i + 1 < argc)
+    {
+      Opts->Ramp = sscanf(argv[++i], "%lf,%lf,%lf", &Opts->RampFromF, &Opts->RampToF, &Opts->RampSec) == 3;
+      if (!Opts->Ramp || Opts->RampSec <= 0)                usage();
+    }
+    else if (argv[i][0] == '-')                         usage();
+    else                                                Opts->Path = argv[i];
+  }
+
+  if (Opts->AdcBits == 0 || Opts->AdcBits > 16 || Opts->RateHz <= 0)
+  {
+    usage();
+  }
+}
+
+
+// ADC code whose converted temperature is closest to TempF, by bisection
+static uint16_t tempToCode(double TempF, unsigned char AdcBits)
+{
+  uint16_t lo = 1, hi = (1 << AdcBits) - 2;
+  bool rising = convertResToTemp(convertAdcToRes(hi, AdcBits)) > convertResToTemp(convertAdcToRes(lo, AdcBits));
+
+  while (lo < hi)
+  {
+    uint16_t mid = lo + (hi - lo) / 2;
+    if ((convertResToTemp(convertAdcToRes(mid, AdcBits)) < TempF) == rising)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+
+  return lo;
+}
+
+
+/***********************************************************************************
+ * @brief - makeRampBlock()
+ *  Makes up to BLOCK_LEN samples of the --ramp trace.
+ *
+ * @return - unsigned long: Number of samples made, 0 at the end of the ramp
+ ***********************************************************************************/
+static unsigned long makeRampBlock(PTR_TRACE_OPTIONS Opts, unsigned long FirstIndex,
+                                   uint16_t * Codes, unsigned long * TimesMs)
+{
+  unsigned long total = (unsigned long)(Opts->RampSec * Opts->RateHz);
+  unsigned long n = 0;
+  int maxCode = (1 << Opts->AdcBits) - 1;
+
+  while (n < BLOCK_LEN && FirstIndex + n < total)
+  {
+    double sec = (FirstIndex + n) / Opts->RateHz;
+    double tempF = Opts->RampFromF + (Opts->RampToF - Opts->RampFromF) * sec / Opts->RampSec;
+    int code = tempToCode(tempF, Opts->AdcBits);
+
+    if (Opts->NoiseCodes > 0)
+    {
+      code += rand() % (2 * Opts->NoiseCodes + 1) - Opts->NoiseCodes;
+      code = code < 0 ? 0 : (code > maxCode ? maxCode : code);
+    }
+
+    Codes[n] = (uint16_t)code;
+    TimesMs[n] = (unsigned long)(sec * 1000.0);
+    n++;
+  }
+
+  return n;
+}
+
+
+/***********************************************************************************
+ * @brief - readBlock()
+ *  Reads up to BLOCK_LEN samples. Samples without a timestamp are timed from
+ *    the sample index and --rate.
+ *
+ * @return - unsigned long: Number of samples read, 0 at end of input
+ ***********************************************************************************/
+static unsigned long readBlock(FILE * In, PTR_TRACE_OPTIONS Opts, unsigned long FirstIndex,
+                               uint16_t * Codes, unsigned long * TimesMs)
+{
+  unsigned long n = 0;
+
+  if (Opts->Binary)
+  {
+    unsigned char raw[BLOCK_LEN * 2];
+    n = fread(raw, 2, BLOCK_LEN, In);
+    for (unsigned long i = 0; i < n; i++)
+    {
+      Codes[i] = raw[2 * i] | (raw[2 * i + 1] << 8);
+      TimesMs[i] = (unsigned long)((FirstIndex + i) * 1000.0 / Opts->RateHz);
+    }
+    return n;
+  }
+
+  char line[128];
+  while (n < BLOCK_LEN && fgets(line, sizeof(line), In))
+  {
+    unsigned long timeMs, code;
+    if (sscanf(line, "%lu,%lu", &timeMs, &code) == 2)
+    {
+      TimesMs[n] = timeMs;
+    }
+    else if (sscanf(line, "%lu", &code) == 1)
+    {
+      TimesMs[n] = (unsigned long)((FirstIndex + n) * 1000.0 / Opts->RateHz);
+    }
+    else
+    {
+      continue;     // Header or blank line
+    }
+
+    Codes[n++] = (uint16_t)code;
+  }
+
+  return n;
+}
+
+
+static void printLatency(const char * Name, long Ms, long RawMs)
+{
+  if (Ms < 0)
+  {
+    fprintf(stderr, "  %-22s never\n", Name);
+  }
+  else
+  {
+    fprintf(stderr, "  %-22s %ld ms (%+ld ms vs raw)\n", Name, Ms, RawMs < 0 ? 0 : Ms - RawMs);
+  }
+}
+
+
+int main(int argc, char ** argv)
+{
+  TRACE_OPTIONS opts;
+  LATENCY_MARKS marks = { -1, -1, -1 };
+  static FIXED_BOXCAR_FILTER<GaugeConfig::NumSamples> filter;      // Same filter as getTempAvg()
+  FILE * in = stdin;
+
+  static uint16_t codes[BLOCK_LEN];
+  static unsigned long timesMs[BLOCK_LEN];
+  static float res[BLOCK_LEN];
+  static float temps[BLOCK_LEN];
+
+  unsigned long total = 0, n;
+  double convertSec = 0, startSec;
+
+  parseArgs(argc, argv, &opts);
+  srand(1);
+  if (!opts.Ramp && opts.Path && !(in = fopen(opts.Path, opts.Binary ? "rb" : "r")))
+  {
+    perror(opts.Path);
+    return 1;
+  }
+
+  historyInit();
+  trendInit();
+
+  if (!opts.Quiet)
+  {
+    printf("time_ms,code,res_ohms,temp_f,avg_f,slope_f_per_s,alarm\n");
+  }
+
+  startSec = nowSec();
+  while ((n = opts.Ramp ? makeRampBlock(&opts, total, codes, timesMs)
+                       : readBlock(in, &opts, total, codes, timesMs)) > 0)
+  {
+    double t0 = nowSec();
+    convertAdcToTempBatch(codes, res, temps, n, opts.AdcBits);
+    convertSec += nowSec() - t0;
+
+    for (unsigned long i = 0; i < n; i++)
+    {
+      // Same order as getTempAvg()
+      int temp = int(temps[i]);
+      int avg;
+      TREND_ALARM_STATE alarm;
+
+      if (total + i == 0)
+      {
+        boxcarInit(&filter, temp);
+      }
+
+      historyAddSample(temp, timesMs[i]);
+      alarm = trendAddSample(temp, timesMs[i]);
+      avg = boxcarPush(&filter, temp);
+
+      if (marks.RawCrossMs < 0 && temp >= TREND_ALARM_TEMP_F)      marks.RawCrossMs = timesMs[i];
+      if (marks.AvgCrossMs < 0 && avg >= TREND_ALARM_TEMP_F)       marks.AvgCrossMs = timesMs[i];
+      if (marks.AlarmSetMs < 0 && alarm != TREND_ALARM_CLEAR)      marks.AlarmSetMs = timesMs[i];
+
+      if (!opts.Quiet)
+      {
+        printf("%lu,%u,%.2f,%.2f,%d,%.3f,%d\n", timesMs[i], codes[i], res[i], temps[i],
+               avg, trendGetSlope(), alarm);
+      }
+    }
+
+    total += n;
+  }
+
+  double totalSec = nowSec() - startSec;
+
+  fprintf(stderr, "%lu samples\n", total);
+  if (total > 0 && convertSec > 0 && totalSec > 0)
+  {
+    fprintf(stderr, "  batch conversion       %.1f Msamples/s\n", total / convertSec / 1e6);
+    fprintf(stderr, "  full chain incl. I/O   %.1f Msamples/s\n", total / totalSec / 1e6);
+  }
+
+  fprintf(stderr, "Time to reach %dF:\n", TREND_ALARM_TEMP_F);
+  printLatency("raw sample", marks.RawCrossMs, marks.RawCrossMs);
+  printLatency("predictive alarm", marks.AlarmSetMs, marks.RawCrossMs);
+  printLatency("display average", marks.AvgCrossMs, marks.RawCrossMs);
+
+  if (in != stdin)
+  {
+    fclose(in);
+  }
+
+  return 0;
+}
@@ -0,0 +1,131 @@
+from pathlib import Path
+import argparse
+import re
+
+SCRIPT_DIR = str(Path(__file__).resolve().parent)
+
+WIDTH = 128
+HEIGHT = 64
+LEVELS = 4                      # 2bpp, see halGray.hpp
+
+# 3x3 smoothing used to give 1bpp art soft edges
+KERNEL = [[1, 2, 1],
+          [2, 4, 2],
+          [1, 2, 1]]
+
+
+# **************************************************************************
+# * @brief - readCArray()
+# * Reads a 1bpp image from a C array in drawBitmap() layout (row-major,
+# * MSB = leftmost pixel), e.g. HAPPY_CHIBI in src/baseChibis.cpp.
+# *
+# * @return - HEIGHT rows of WIDTH values between 0 and 1
+# *************************************************************************
+def readCArray(path, name):
+    text = Path(path).read_text()
+    match = re.search(re.escape(name) + r'\s*\[[^\]]*\]\s*(?:PROGMEM)?\s*=\s*\{(.*?)\}', text, re.S)
+    if not match:
+        raise SystemExit('Array %s not found in %s' % (name, path))
+
+    data = [int(b, 16) for b in re.findall(r'0x[0-9a-fA-F]+', match.group(1))]
+    rows = []
+    for y in range(HEIGHT):
+        row = []
+        for x in range(WIDTH):
+            i = y * (WIDTH // 8) + x // 8
+            row.append(((data[i] >> (7 - x % 8)) & 1) if i < len(data) else 0)
+        rows.append(row)
+    return rows
+
+
+# **************************************************************************
+# * @brief - readPgm()
+# * Reads a binary (P5) or ASCII (P2) PGM. Anything outside 128x64 is
+# * cropped, anything missing is black.
+# *
+# * @return - HEIGHT rows of WIDTH values between 0 and 1
+# *************************************************************************
+def readPgm(path):
+    data = Path(path).read_bytes()
+    tokens = re.findall(rb'\S+', re.sub(rb'#[^\n]*', b'', data[:64]))
+    magic, w, h, maxVal = tokens[0], int(tokens[1]), int(tokens[2]), int(tokens[3])
+
+    if magic == b'P5':
+        header = re.match(rb'P5\s+(?:#[^\n]*\n\s*)*\d+\s+\d+\s+\d+\s', data).end()
+        pixels = list(data[header:header + w * h])
+    elif magic == b'P2':
+        pixels = [int(t) for t in re.findall(rb'\d+', re.sub(rb'#[^\n]*', b'', data))[4:4 + w * h]]
+    else:
+        raise SystemExit('Only P2 and P5 PGM files are supported')
+
+    return [[pixels[y * w + x] / maxVal if x < w and y < h else 0 for x in range(WIDTH)]
+            for y in range(HEIGHT)]
+
+
+def smooth(rows):
+    out = []
+    for y in range(HEIGHT):
+        row = []
+        for x in range(WIDTH):
+            total = 0
+            for ky in range(3):
+                for kx in range(3):
+                    sy = min(max(y + ky - 1, 0), HEIGHT - 1)     # Repeat the edge pixels
+                    sx = min(max(x + kx - 1, 0), WIDTH - 1)
+                    total += KERNEL[ky][kx] * rows[sy][sx]
+            row.append(total / 16)
+        out.append(row)
+    return out
+
+
+# **************************************************************************
+# * @brief - toPlanes()
+# * Quantizes to 4 levels and splits into High and Low planes in SSD1306
+# * page layout (byte = 8 rows of one column, LSB on top).
+# *
+# * @return - (high, low) byte lists
+# *************************************************************************
+def toPlanes(rows, invert):
+    high = [0] * (WIDTH * HEIGHT // 8)
+    low = [0] * (WIDTH * HEIGHT // 8)
+    for y in range(HEIGHT):
+        for x in range(WIDTH):
+            value = 1 - rows[y][x] if invert else rows[y][x]
+            level = min(LEVELS - 1, int(value * (LEVELS - 1) + 0.5))
+            i = (y // 8) * WIDTH + x
+            if level & 2:
+                high[i] |= 1 << (y % 8)
+            if level & 1:
+                low[i] |= 1 << (y % 8)
+    return high, low
+
+
+def writeArray(f, name, data):
+    f.write('const unsigned char %s [LEN_IMG_BYTE_ARR] PROGMEM = {\n\t' % name)
+    for i, byte in enumerate(data):
+        f.write('0x%02x' % byte)
+        if i < len(data) - 1:
+            f.write(', ')
+        if i % 16 == 15 and i < len(data) - 1:
+            f.write('\n\t')
+    f.write('\n};\n\n')
+
+
+if (__name__ == "__main__"):
+    parser = argparse.ArgumentParser(description='Convert an image to the two 2bpp planes used by halGray')
+    parser.add_argument('input', help='PGM image, or a C source file with --array')
+    parser.add_argument('--array', help='Name of a 1bpp drawBitmap() array in the input file')
+    parser.add_argument('--name', default='GRAY_IMAGE', help='Prefix for the generated arrays')
+    parser.add_argument('--smooth', action='store_true', help='Soften edges, for 1bpp input')
+    parser.add_argument('--invert', action='store_true')
+    args = parser.parse_args()
+
+    rows = readCArray(args.input, args.array) if args.array else readPgm(args.input)
+    if args.smooth:
+        rows = smooth(rows)
+    high, low = toPlanes(rows, args.invert)
+
+    Path(SCRIPT_DIR, 'outputs').mkdir(exist_ok=True)
+    with open(SCRIPT_DIR + '/outputs/grayPlanesOut.txt', 'w') as f:
+        writeArray(f, args.name + '_HIGH', high)
+        writeArray(f, args.name + '_LOW', low)
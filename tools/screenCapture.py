@@ -0,0 +1,170 @@
+from pathlib import Path
+import argparse
+import serial               # pip install pyserial
+
+SCRIPT_DIR = str(Path(__file__).resolve().parent)
+
+# Must match halCapture.hpp
+SYNC = b'\xA5\x5A'
+HEADER_LEN = 6
+TYPE_KEYFRAME = 0
+TYPE_DELTA = 1
+
+WIDTH = 128
+HEIGHT = 64
+FRAME_BYTES = WIDTH * HEIGHT // 8
+
+
+# **************************************************************************
+# * @brief - readRecord()
+# * Skips text until the sync word, then reads one capture record. Debug
+# * prints from the firmware land between records, never inside one.
+# *
+# * @return - (type, seq, payload) or None if the checksum doesn't match
+# *************************************************************************
+def readRecord(port):
+    window = b''
+    while window != SYNC:
+        byte = port.read(1)
+        if not byte:
+            continue
+        window = (window + byte)[-2:]
+
+    header = port.read(HEADER_LEN - 2)
+    recType, seq = header[0], header[1]
+    length = header[2] | (header[3] << 8)
+    if length > FRAME_BYTES:
+        return None
+
+    payload = port.read(length)
+    check = port.read(1)
+
+    xor = 0
+    for byte in payload:
+        xor ^= byte
+    if len(payload) != length or not check or check[0] != xor:
+        return None
+
+    return recType, seq, payload
+
+
+# **************************************************************************
+# * @brief - applyRecord()
+# * Rebuilds the framebuffer from a record. Deltas are (Value, Reps) pairs
+# * XORed onto the last frame.
+# *
+# * @return - bytearray frame, or None if a delta arrives with no base frame
+# *************************************************************************
+def applyRecord(frame, recType, payload):
+    if recType == TYPE_KEYFRAME:
+        return bytearray(payload)
+
+    if recType != TYPE_DELTA or frame is None:
+        return None
+
+    out = bytearray(frame)
+    i = 0
+    for p in range(0, len(payload) - 1, 2):
+        value, reps = payload[p], payload[p + 1]
+        for _ in range(reps):
+            if i < FRAME_BYTES:
+                out[i] ^= value
+            i += 1
+
+    if i != FRAME_BYTES:
+        return None
+    return out
+
+
+# SSD1306 page layout: byte = 8 vertical pixels, LSB on top
+def pixel(frame, x, y):
+    return (frame[(y // 8) * WIDTH + x] >> (y % 8)) & 1
+
+
+def writePgm(frame, path, scale):
+    with open(path, 'wb') as f:
+        f.write(('P5\n%d %d\n255\n' % (WIDTH * scale, HEIGHT * scale)).encode())
+        for y in range(HEIGHT):
+            row = bytearray()
+            for x in range(WIDTH):
+                row += bytes([255 * pixel(frame, x, y)]) * scale
+            f.write(bytes(row) * scale)
+
+
+def printAscii(frame):
+    lines = []
+    for y in range(0, HEIGHT, 2):
+        line = ''
+        for x in range(WIDTH):
+            top, bottom = pixel(frame, x, y), pixel(frame, x, y + 1)
+            line += ' ▄▀█'[top * 2 + bottom]
+        lines.append(line)
+    print('\x1b[H' + '\n'.join(lines), flush=True)
+
+
+# **************************************************************************
+# * @brief - screenCapture()
+# * Asks the firmware for frames and shows them in the terminal or writes
+# * them to outputs/ as PGM images.
+# *
+# * @return - None
+# *************************************************************************
+def screenCapture(args):
+    outDir = Path(SCRIPT_DIR) / 'outputs'
+    if args.pgm:
+        outDir.mkdir(exist_ok=True)
+
+    with serial.Serial(args.port, args.baud, timeout=1) as port:
+        port.write(b'C' if args.count != 1 else b'c')
+
+        frame = None
+        lastSeq = None
+        shown = 0
+        dropped = 0
+        totalBytes = 0
+        try:
+            while args.count == 0 or shown < args.count:
+                record = readRecord(port)
+                if record is None:
+                    dropped += 1
+                    frame = None    # Wait for the next keyframe
+                    continue
+
+                recType, seq, payload = record
+                if recType not in (TYPE_KEYFRAME, TYPE_DELTA):
+                    lastSeq = seq
+                    continue    # Some other record, e.g. a histogram dump
+
+                if lastSeq is not None and seq != (lastSeq + 1) & 0xFF and recType == TYPE_DELTA:
+                    frame = None    # Missed a record, the delta base is stale
+                lastSeq = seq
+
+                frame = applyRecord(frame, recType, payload)
+                if frame is None:
+                    continue
+
+                totalBytes += HEADER_LEN + len(payload) + 1
+                shown += 1
+                if args.pgm:
+                    writePgm(frame, outDir / ('capture_%05d.pgm' % shown), args.scale)
+                else:
+                    printAscii(frame)
+        finally:
+            port.write(b'x')
+
+        if shown:
+            print('%d frames, %d dropped, %.1f bytes/frame (raw %d)'
+                  % (shown, dropped, totalBytes / shown, FRAME_BYTES))
+
+
+if (__name__ == "__main__"):
+    parser = argparse.ArgumentParser(description='View the OLED framebuffer streamed by halCapture')
+    parser.add_argument('port', help='Serial port, e.g. /dev/ttyACM0 or COM3')
+    parser.add_argument('--baud', type=int, default=9600)
+    parser.add_argument('--count', type=int, default=0, help='Frames to capture, 0 = until Ctrl-C')
+    parser.add_argument('--pgm', action='store_true', help='Write outputs/capture_NNNNN.pgm instead of drawing in the terminal')
+    parser.add_argument('--scale', type=int, default=4, help='PGM pixel scale')
+    try:
+        screenCapture(parser.parse_args())
+    except KeyboardInterrupt:
+        pass
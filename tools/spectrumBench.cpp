@@ -0,0 +1,200 @@
+/*
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*   spectrumBench.cpp
+*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*
+*   Host tool that runs the noise analysis from baseSpectrum on a burst of
+*   raw ADC codes and times it. Without a FILE it makes a synthetic burst:
+*   the thermistor's DC level plus a low ignition-like tone, an alternator
+*   whine that falls between two bins, and white noise. It then checks that
+*   both tones are reported. The on-device numbers come from the 'n' serial
+*   command, see thermistorNoiseReport().
+*
+*   Build from the repo root:
+*     g++ -O2 -Iinclude tools/spectrumBench.cpp src/baseSpectrum.cpp -o spectrumBench
+*
+*   Usage:
+*     spectrumBench [--rate HZ] [--samples N] [--iters N] [FILE]
+*
+*     FILE holds one raw code per line, e.g. a burst logged from the device.
+*     --rate is the rate the burst was sampled at.
+*
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "baseSpectrum.hpp"
+
+#define MAX_SAMPLES         65536
+#define DEFAULT_RATE_HZ     2000        // BURST_RATE_HZ on seeed_xiao
+#define DEFAULT_SAMPLES     4096        // BURST_NUM_SAMPLES on seeed_xiao
+#define DEFAULT_ITERS       20
+
+#define SYNTH_DC            2400        // Around 180F on the 12-bit ADC
+#define SYNTH_LOW_HZ        125.0       // On a bin at 2 kHz
+#define SYNTH_LOW_AMP       30.0
+#define SYNTH_WHINE_HZ      437.0       // Between two bins
+#define SYNTH_WHINE_AMP     12.0
+#define SYNTH_NOISE_AMP     4           // Uniform, +-codes
+
+typedef struct _BENCH_OPTIONS
+{
+  double RateHz;
+  unsigned int NumSamples;
+  unsigned int Iters;
+  const char * Path;
+} BENCH_OPTIONS, *PTR_BENCH_OPTIONS;
+
+
+static double nowSec()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+static void usage()
+{
+  fprintf(stderr, "usage: spectrumBench [--rate HZ] [--samples N] [--iters N] [FILE]\n");
+  exit(2);
+}
+
+
+static void parseArgs(int argc, char ** argv, PTR_BENCH_OPTIONS Opts)
+{
+  Opts->RateHz = DEFAULT_RATE_HZ;
+  Opts->NumSamples = DEFAULT_SAMPLES;
+  Opts->Iters = DEFAULT_ITERS;
+  Opts->Path = 0;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (!strcmp(argv[i], "--rate") && i + 1 < argc)          Opts->RateHz = atof(argv[++i]);
+    else if (!strcmp(argv[i], "--samples") && i + 1 < argc)  Opts->NumSamples = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--iters") && i + 1 < argc)    Opts->Iters = atoi(argv[++i]);
+    else if (argv[i][0] == '-')                              usage();
+    else                                                     Opts->Path = argv[i];
+  }
+
+  if (Opts->RateHz <= 0 || Opts->NumSamples < SPECTRUM_SEG_LEN || Opts->NumSamples > MAX_SAMPLES || Opts->Iters == 0)
+  {
+    usage();
+  }
+}
+
+
+static unsigned int readBurst(const char * Path, int16_t * Samples)
+{
+  FILE * in = fopen(Path, "r");
+  char line[64];
+  unsigned int n = 0;
+  long code;
+
+  if (!in)
+  {
+    perror(Path);
+    exit(1);
+  }
+
+  while (n < MAX_SAMPLES && fgets(line, sizeof(line), in))
+  {
+    if (sscanf(line, "%ld", &code) == 1)
+    {
+      Samples[n++] = (int16_t)code;
+    }
+  }
+
+  fclose(in);
+  return n;
+}
+
+
+static void makeBurst(PTR_BENCH_OPTIONS Opts, int16_t * Samples)
+{
+  srand(1);
+  for (unsigned int i = 0; i < Opts->NumSamples; i++)
+  {
+    double t = i / Opts->RateHz;
+    double v = SYNTH_DC
+             + SYNTH_LOW_AMP * sin(2 * M_PI * SYNTH_LOW_HZ * t)
+             + SYNTH_WHINE_AMP * sin(2 * M_PI * SYNTH_WHINE_HZ * t + 1.0)
+             + (rand() % (2 * SYNTH_NOISE_AMP + 1)) - SYNTH_NOISE_AMP;
+    Samples[i] = (int16_t)lround(v);
+  }
+}
+
+
+// True if one of the peaks is within a bin of FreqHz
+static bool hasPeak(const SPECTRUM_PEAK * Peaks, unsigned char NumPeaks, double FreqHz, double BinHz)
+{
+  for (unsigned char i = 0; i < NumPeaks; i++)
+  {
+    if (fabs(Peaks[i].FreqHz - FreqHz) <= BinHz)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+int main(int argc, char ** argv)
+{
+  BENCH_OPTIONS opts;
+  static int16_t samples[MAX_SAMPLES];
+  float amplitude[SPECTRUM_NUM_BINS + 1];
+  SPECTRUM_PEAK peaks[SPECTRUM_MAX_PEAKS];
+  unsigned char numPeaks;
+  double binHz, startSec, sec;
+
+  parseArgs(argc, argv, &opts);
+  if (opts.Path)
+  {
+    opts.NumSamples = readBurst(opts.Path, samples);
+  }
+  else
+  {
+    makeBurst(&opts, samples);
+  }
+
+  spectrumInit();
+  if (spectrumAnalyze(samples, opts.NumSamples, amplitude) != SPECTRUM_STATUS_SUCCESS)
+  {
+    fprintf(stderr, "Need at least %d samples\n", SPECTRUM_SEG_LEN);
+    return 1;
+  }
+
+  startSec = nowSec();
+  for (unsigned int i = 0; i < opts.Iters; i++)
+  {
+    spectrumAnalyze(samples, opts.NumSamples, amplitude);
+  }
+  sec = (nowSec() - startSec) / opts.Iters;
+
+  binHz = opts.RateHz / SPECTRUM_SEG_LEN;
+  numPeaks = spectrumFindPeaks(amplitude, opts.RateHz, peaks, SPECTRUM_MAX_PEAKS);
+
+  printf("%u samples at %.1f Hz, %d bins of %.2f Hz, %u segments\n", opts.NumSamples, opts.RateHz,
+         SPECTRUM_NUM_BINS, binHz, opts.NumSamples / SPECTRUM_SEG_LEN);
+  printf("  analysis               %.3f ms\n", sec * 1e3);
+  printf("  per sample-bin         %.2f ns\n", sec * 1e9 / (double(opts.NumSamples) * SPECTRUM_NUM_BINS));
+  printf("Peaks (Hz, ADC codes):\n");
+  for (unsigned char i = 0; i < numPeaks; i++)
+  {
+    printf("  %8.1f  %7.2f\n", peaks[i].FreqHz, peaks[i].Amplitude);
+  }
+
+  if (!opts.Path)
+  {
+    bool ok = numPeaks >= 2 && hasPeak(peaks, 2, SYNTH_LOW_HZ, binHz) && hasPeak(peaks, 2, SYNTH_WHINE_HZ, binHz);
+
+    printf("Synthetic tones at %.1f and %.1f Hz: %s\n", SYNTH_LOW_HZ, SYNTH_WHINE_HZ, ok ? "found" : "MISSED");
+    return ok ? 0 : 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,79 @@
+from pathlib import Path
+import argparse
+import struct
+import serial               # pip install pyserial
+
+from screenCapture import readRecord
+
+SCRIPT_DIR = str(Path(__file__).resolve().parent)
+
+# Must match halCapture.hpp / baseTempHist.hpp
+TYPE_TEMP_HIST = 2
+TEMPHIST_MAGIC = 0x5448
+HEADER_FORMAT = '<HBBhH'
+
+
+# **************************************************************************
+# * @brief - parseTempHist()
+# * Unpacks a TEMPHIST_RECORD payload.
+# *
+# * @return - (minF, widthF, [seconds per bucket])
+# *************************************************************************
+def parseTempHist(payload):
+    magic, version, numBuckets, minF, widthF = struct.unpack_from(HEADER_FORMAT, payload)
+    if magic != TEMPHIST_MAGIC:
+        raise ValueError('Not a histogram record')
+
+    seconds = list(struct.unpack_from('<%dI' % numBuckets, payload, struct.calcsize(HEADER_FORMAT)))
+    return minF, widthF, seconds
+
+
+def bandName(minF, widthF, bucket, numBuckets):
+    low = minF + (bucket - 1) * widthF
+    if bucket == 0:
+        return '< %dF' % minF
+    if bucket == numBuckets - 1:
+        return '>= %dF' % low
+    return '%d-%dF' % (low, low + widthF - 1)
+
+
+# **************************************************************************
+# * @brief - tempHistDump()
+# * Asks the firmware for the time-at-temperature histogram and prints it,
+# * optionally appending it to a CSV file.
+# *
+# * @return - None
+# *************************************************************************
+def tempHistDump(args):
+    with serial.Serial(args.port, args.baud, timeout=1) as port:
+        port.reset_input_buffer()
+        port.write(b'h')
+
+        while True:
+            record = readRecord(port)
+            if record is not None and record[0] == TYPE_TEMP_HIST:
+                break
+
+    minF, widthF, seconds = parseTempHist(record[2])
+    total = sum(seconds)
+    peak = max(seconds) if total else 1
+
+    for i, sec in enumerate(seconds):
+        bar = '#' * round(40 * sec / peak)
+        share = 100.0 * sec / total if total else 0
+        print('%-10s %8.2f h %5.1f%%  %s' % (bandName(minF, widthF, i, len(seconds)), sec / 3600, share, bar))
+    print('total      %8.2f h' % (total / 3600))
+
+    if args.csv:
+        with open(args.csv, 'w') as f:
+            f.write('band,low_f,seconds\n')
+            for i, sec in enumerate(seconds):
+                f.write('%s,%d,%d\n' % (bandName(minF, widthF, i, len(seconds)), minF + (i - 1) * widthF, sec))
+
+
+if (__name__ == "__main__"):
+    parser = argparse.ArgumentParser(description='Read the time-at-temperature histogram from the gauge')
+    parser.add_argument('port', help='Serial port, e.g. /dev/ttyACM0 or COM3')
+    parser.add_argument('--baud', type=int, default=9600)
+    parser.add_argument('--csv', help='Also write the histogram to this CSV file')
+    tempHistDump(parser.parse_args())